@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace advent
+{
+	// Counts of heap allocations made through the global operator new (and through counting_allocator).
+	// The counters are per thread, so tests running in parallel do not see each other's allocations.
+	struct allocation_stats
+	{
+		std::size_t num_allocations = 0;
+
+		// Sum of the sizes asked for.
+		std::size_t bytes_allocated = 0;
+
+		// Bytes currently held, as the allocator sees them (so including any rounding up it does).
+		// Signed because memory can be freed on a different thread from the one that allocated it.
+		std::ptrdiff_t live_bytes = 0;
+
+		// Highest live_bytes has been since the thread started or reset_thread_peak_live_bytes was last called.
+		std::ptrdiff_t peak_live_bytes = 0;
+
+		// Allocations refused because of the thread's heap limit.
+		std::size_t num_failed_allocations = 0;
+	};
+
+	// Totals for the calling thread since it started. Take the difference of two calls to measure a region.
+	allocation_stats get_thread_allocation_stats() noexcept;
+
+	// Brings the calling thread's peak back down to its current live bytes, so the peak of a region
+	// is the peak at the end minus the live bytes at the start.
+	void reset_thread_peak_live_bytes() noexcept;
+
+	// Makes operator new on the calling thread throw std::bad_alloc rather than take live_bytes over this.
+	// 0 means no limit.
+	void set_thread_heap_limit(std::size_t max_live_bytes) noexcept;
+
+	// Adds to the calling thread's counters. For allocators that get their memory without
+	// going through the global operator new.
+	void record_allocation(std::size_t requested_bytes, std::size_t held_bytes) noexcept;
+	void record_deallocation(std::size_t held_bytes) noexcept;
+
+	// Wraps another allocator and records everything it hands out in the thread's allocation_stats.
+	// Memory from std::allocator is already counted by the global operator new, so this is
+	// for upstream allocators that bypass it.
+	// e.g. utils::small_vector<int, 8, advent::counting_allocator<int, my_arena_allocator<int>>>
+	template <typename T, typename Upstream>
+	class counting_allocator : public Upstream
+	{
+		using upstream_traits = std::allocator_traits<Upstream>;
+		static_assert(std::is_same_v<typename upstream_traits::value_type, T>, "Upstream must allocate T");
+	public:
+		using value_type = T;
+		using upstream_allocator_type = Upstream;
+
+		template <typename U>
+		struct rebind
+		{
+			using other = counting_allocator<U, typename upstream_traits::template rebind_alloc<U>>;
+		};
+
+		counting_allocator() = default;
+		explicit counting_allocator(const Upstream& upstream) : Upstream{ upstream } {}
+		template <typename U, typename OtherUpstream>
+		counting_allocator(const counting_allocator<U, OtherUpstream>& other) : Upstream{ other.upstream() } {}
+
+		const Upstream& upstream() const noexcept { return *this; }
+
+		T* allocate(std::size_t n)
+		{
+			T* result = upstream_traits::allocate(static_cast<Upstream&>(*this), n);
+			record_allocation(n * sizeof(T), n * sizeof(T));
+			return result;
+		}
+
+		void deallocate(T* ptr, std::size_t n)
+		{
+			record_deallocation(n * sizeof(T));
+			upstream_traits::deallocate(static_cast<Upstream&>(*this), ptr, n);
+		}
+
+		bool operator==(const counting_allocator& other) const noexcept
+		{
+			return upstream() == other.upstream();
+		}
+	};
+}
\ No newline at end of file
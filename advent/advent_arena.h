@@ -0,0 +1,36 @@
+#pragma once
+
+#include <memory_resource>
+
+namespace advent
+{
+	// A bump-pointer arena for whatever is running on the calling thread. Allocating is a pointer bump and
+	// freeing does nothing. The harness releases everything in it at the end of each run of a test (and each
+	// puzzle solved by --serve, --batch and --stdin), so nothing allocated from it may outlive the run.
+	// The arena keeps its memory between runs, growing to fit the biggest run so far, so a solver that uses
+	// it only goes to the heap on its first run.
+	std::pmr::memory_resource* get_test_arena();
+
+	// For containers that take an allocator, e.g.
+	// utils::small_vector<int, 8, advent::arena_allocator<int>> v{ advent::get_arena_allocator<int>() };
+	// Copies made with a copy constructor go back to the heap (polymorphic_allocator does not propagate),
+	// so pass the allocator to copies that should stay in the arena.
+	template <typename T>
+	using arena_allocator = std::pmr::polymorphic_allocator<T>;
+
+	template <typename T>
+	arena_allocator<T> get_arena_allocator()
+	{
+		return arena_allocator<T>{ get_test_arena() };
+	}
+
+	// Marks one run of a test or puzzle. The arena is released when the outermost one on the thread ends.
+	class scoped_test_arena
+	{
+	public:
+		scoped_test_arena() noexcept;
+		~scoped_test_arena();
+		scoped_test_arena(const scoped_test_arena&) = delete;
+		scoped_test_arena& operator=(const scoped_test_arena&) = delete;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "advent_of_code.h"
+
+namespace advent
+{
+	// Solves options.day (both parts unless options.part is set) for every input listed by options.batch.input_path, on
+	// options.num_threads workers. Each input's answers are printed in list order as soon as they are known,
+	// followed by the overall throughput.
+	// input_path is either a directory, in which case every file in it is used in name order, or a manifest:
+	// a text file with one input file per line. Blank lines and lines starting with '#' are skipped, and
+	// relative paths are relative to the manifest's directory.
+	// Returns false if the inputs could not be listed or any of them failed.
+	bool run_batch(const verify_options& options);
+}
\ No newline at end of file
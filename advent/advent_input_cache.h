@@ -0,0 +1,13 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace advent
+{
+	// Returns the whole contents of a file. The file is memory-mapped the first time it is asked for
+	// and stays mapped until the program exits, so later calls (from any thread) cost a lookup.
+	// Fails an AdventCheck if the file does not exist the first time, and is empty if the file is empty or
+	// could not be read.
+	std::string_view get_input_view(const std::string& filename);
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <string>
+#include <optional>
+#include <cstddef>
+#include <cstdint>
+
+namespace advent
+{
+	// Makes a valid puzzle input for the day about `scale` times the size of a real one (in lines,
+	// grid cells or bricks, as suits the day). The same day, scale and seed always give the same input,
+	// on every platform.
+	// Returns nullopt for days that have no generator yet.
+	std::optional<std::string> generate_input(int day, std::size_t scale, std::uint64_t seed);
+
+	bool has_input_generator(int day) noexcept;
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+
+namespace advent
+{
+	// Resident memory of the whole process, so only attributable to one test when tests run one at a time.
+
+	// Resets the peak reported by get_peak_rss_bytes to the current resident size.
+	// Returns false where that is not possible (anything but Linux, or a kernel that does not allow it),
+	// in which case the peak is the highest since the process started.
+	bool reset_peak_rss() noexcept;
+
+	std::optional<std::size_t> get_current_rss_bytes();
+	std::optional<std::size_t> get_peak_rss_bytes();
+}
\ No newline at end of file
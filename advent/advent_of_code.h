@@ -2,5 +2,134 @@
 
 #include <string_view>
 #include <vector>
+#include <optional>
+#include <cstddef>
+#include <chrono>
+#include <cstdint>
 
+// Settings for repeating each test to get timings that can be compared between runs.
+struct benchmark_options
+{
+	// Untimed runs done before measuring, on top of the normal checked run.
+	std::size_t warmup_runs = 1;
+
+	// Stop after this many timed runs. 0 means no limit (so time_budget must be set).
+	std::size_t max_runs = 0;
+
+	// Stop once this much time has been spent on timed runs. 0 means no limit.
+	std::chrono::milliseconds time_budget{ 0 };
+
+	bool enabled() const noexcept { return max_runs > 0 || time_budget.count() > 0; }
+};
+
+// Settings for saving results to a file and checking timings against an earlier run.
+struct export_options
+{
+	// Write the results here. A ".csv" extension gives CSV; anything else gives JSON.
+	std::string_view output_path;
+
+	// Results file from an earlier run (either format) to compare timings against.
+	std::string_view baseline_path;
+
+	// A test has regressed if it is this many percent slower than the baseline...
+	double regression_threshold_percent = 10.0;
+
+	// ...and at least this much slower in absolute terms, so tiny tests do not trip on noise.
+	std::chrono::microseconds regression_floor{ 100 };
+
+	// Write each test's AdventZones here as a Chrome trace (for chrome://tracing, Perfetto, speedscope...).
+	std::string_view trace_path;
+};
+
+// Settings for timing solvers on generated inputs of increasing size (see advent_input_generators.h).
+struct sweep_options
+{
+	// Run each solver at scales 1, 2, 5, 10, 20, 50... up to this. 0 turns the sweep off.
+	std::size_t max_scale = 0;
+
+	// The same seed gives the same inputs.
+	std::uint64_t seed = 1;
+
+	bool enabled() const noexcept { return max_scale > 0; }
+};
+
+// Settings for solving one day's puzzle for many inputs (see advent_batch.h).
+struct batch_options
+{
+	// A directory of input files, or a manifest file listing them. Empty turns batch mode off.
+	std::string_view input_path;
+
+	// Most inputs read but not yet solved. 0 means twice the number of threads.
+	std::size_t max_queued = 0;
+
+	bool enabled() const noexcept { return !input_path.empty(); }
+};
+
+// Settings for a run of verify_all.
+struct verify_options
+{
+	// Only run tests with one of these in their name. Leave empty to run everything.
+	std::vector<std::string_view> filters;
+
+	// How many tests to run at once. 1 runs them in order on the calling thread; 0 uses every hardware thread.
+	// With more than one, tests must not change std::cout's or std::cerr's format state, which the threads share.
+	std::size_t num_threads = 1;
+
+	// Benchmarking is off unless --bench or --bench-time is given.
+	benchmark_options benchmark;
+
+	export_options export_settings;
+
+	// Read hardware performance counters around each test's checked run (Linux only).
+	bool perf_counters = false;
+
+	// Report the number of allocations, bytes allocated and peak live bytes for each test's checked run.
+	bool allocation_stats = false;
+
+	// Report each test's peak resident memory. This is for the whole process, so use with -j 1.
+	bool memory_stats = false;
+
+	// Fail any test that grows resident memory by more than this many MiB. Heap allocations on the test's
+	// thread also start failing at that point, so a runaway test stops rather than taking the machine down.
+	// 0 means no limit. Implies memory_stats.
+	std::size_t memory_limit_mb = 0;
+
+	bool measuring_memory() const noexcept { return memory_stats || memory_limit_mb > 0; }
+
+	// Report the time spent in each AdventZone during each test's checked run.
+	bool zones = false;
+
+	// When enabled, verify_all runs the sweep instead of the tests. Filters pick the solvers, and
+	// with --bench N each scale is timed N times and the fastest kept.
+	sweep_options sweep;
+
+	bool recording_zones() const noexcept { return zones || !export_settings.trace_path.empty(); }
+
+	// Run each test in its own process, so a crash is reported against that test instead of ending the run.
+	bool isolate = false;
+
+	// Kill any test still running after this long and report it as timed out. 0 means no limit. Implies isolate.
+	std::chrono::milliseconds timeout{ 0 };
+
+	bool isolating() const noexcept { return isolate || timeout.count() > 0; }
+
+	// When set, verify_all runs a solver server on this Unix domain socket (see advent_server.h) instead of the
+	// tests, with num_threads workers.
+	std::string_view server_socket_path;
+
+	// The puzzle to solve in the modes that solve one (--batch and --stdin). Part 0 means both parts where that is possible.
+	int day = 0;
+	int part = 0;
+
+	// When enabled, verify_all solves day's puzzle for a batch of inputs on num_threads threads instead of running the tests.
+	batch_options batch;
+
+	// When set, verify_all solves day's puzzle (one part) for input read from stdin instead of running the tests.
+	bool read_stdin = false;
+};
+
+// Returns nullopt (after reporting the problem to std::cerr) if the arguments are malformed.
+std::optional<verify_options> parse_verify_options(int argc, char** argv);
+
+bool verify_all(const verify_options& options);
 bool verify_all(const std::vector<std::string_view>& filters);
\ No newline at end of file
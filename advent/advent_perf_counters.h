@@ -0,0 +1,29 @@
+#pragma once
+
+#include <array>
+
+#include "advent_test_result.h"
+
+namespace advent
+{
+	// Hardware event counts for the calling thread between start() and stop().
+	// Uses perf_event_open on Linux. Counters the kernel will not give us (no PMU, perf_event_paranoid,
+	// running in a VM or container...) and all counters on other platforms read as unavailable.
+	class perf_counters
+	{
+		static constexpr std::size_t NUM_COUNTERS = 5;
+		std::array<int, NUM_COUNTERS> m_fds;
+	public:
+		perf_counters();
+		~perf_counters();
+		perf_counters(const perf_counters&) = delete;
+		perf_counters& operator=(const perf_counters&) = delete;
+
+		bool available() const noexcept;
+		void start() noexcept;
+		perf_counter_values stop() noexcept;
+	};
+
+	// Opened the first time it is asked for on each thread and kept until the thread ends.
+	perf_counters& get_thread_perf_counters();
+}
\ No newline at end of file
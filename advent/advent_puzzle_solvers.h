@@ -0,0 +1,46 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <chrono>
+#include <iosfwd>
+
+#include "advent_types.h"
+
+namespace advent
+{
+	// The entry point that solves one part of a day's puzzle (advent_one_p1 and so on).
+	struct puzzle_solver
+	{
+		int day = 0;
+		int part = 0;
+		ResultType(*solve)() = nullptr;
+
+		// For days that read their input a line at a time: the same solution, reading from any stream.
+		// These can get to work before all of the input has arrived.
+		ResultType(*solve_stream)(std::istream&) = nullptr;
+	};
+
+	// Every day and part built into the program (see ADVENT_DAYS), in order.
+	std::span<const puzzle_solver> get_puzzle_solvers() noexcept;
+
+	// nullptr if that day and part is not built in.
+	const puzzle_solver* find_puzzle_solver(int day, int part) noexcept;
+
+	// Runs the solver on input instead of the day's input file. Throws whatever the solver throws.
+	ResultType solve_puzzle(const puzzle_solver& solver, std::string_view input);
+
+	struct puzzle_answer
+	{
+		std::string result; // What went wrong, if failed.
+		std::chrono::nanoseconds time_taken{ 0 };
+		bool failed = false;
+	};
+
+	// As solve_puzzle, but timed and with failures (a failed AdventCheck, running out of memory...) caught.
+	puzzle_answer try_solve_puzzle(const puzzle_solver& solver, std::string_view input);
+
+	// As above, for input from a stream. Uses solve_stream if there is one; otherwise all the input is read first.
+	puzzle_answer try_solve_puzzle(const puzzle_solver& solver, std::istream& input);
+}
\ No newline at end of file
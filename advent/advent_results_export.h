@@ -0,0 +1,62 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <optional>
+#include <chrono>
+#include <iosfwd>
+
+#include "advent_of_code.h"
+#include "advent_test_result.h"
+
+namespace advent
+{
+	enum class results_format : char
+	{
+		json,
+		csv
+	};
+
+	// Picks the format from the file extension.
+	results_format get_results_format(std::string_view path);
+
+	// Filtered tests are left out.
+	void write_results(std::ostream& output, std::span<const test_result> results, results_format format);
+
+	// Returns false if the file could not be written.
+	bool write_results(std::string_view path, std::span<const test_result> results);
+
+	// Reads a file made by write_results. Only the name, status, time, benchmark, counter, allocation and memory fields are restored.
+	// Returns nullopt (after reporting to std::cerr) if the file cannot be opened or parsed.
+	std::optional<std::vector<test_result>> read_results(std::string_view path);
+
+	// As read_results, but from text already in memory. Returns nullopt without reporting anything.
+	std::optional<std::vector<test_result>> parse_results(std::string_view text);
+
+	struct timing_regression
+	{
+		std::string name;
+		std::chrono::nanoseconds baseline_time;
+		std::chrono::nanoseconds current_time;
+	};
+
+	// Writes the zones of every test that recorded them in Chrome's trace event format, one track per thread.
+	// Returns false if the file could not be written.
+	bool write_chrome_trace(std::string_view path, std::span<const test_result> results);
+
+	struct status_change
+	{
+		std::string name;
+		std::string_view baseline_status;
+		std::string_view current_status;
+	};
+
+	// Tests in both lists that got slower by more than the thresholds in options. Only tests that passed or have
+	// no known answer in both lists are compared, as a failing or crashing run's time says little.
+	std::vector<timing_regression> find_regressions(std::span<const test_result> results, std::span<const test_result> baseline, const export_options& options);
+
+	// Tests in both lists whose status is different in results, e.g. "pass" to "fail".
+	std::vector<status_change> find_status_changes(std::span<const test_result> results, std::span<const test_result> baseline);
+}
\ No newline at end of file
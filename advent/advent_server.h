@@ -0,0 +1,22 @@
+#pragma once
+
+#include <string_view>
+#include <cstddef>
+
+namespace advent
+{
+	// Whether run_server can work here (POSIX only).
+	bool can_run_server() noexcept;
+
+	// Keeps the program running and answers requests to solve puzzles, so a caller that needs many answers
+	// pays for process startup once. Each connection is read on its own thread and may send any number of
+	// requests, one after another. The solving is done by num_threads workers (0 for one per hardware thread).
+	// Connections that send nothing for 30 seconds are closed.
+	//
+	// A request is a line "DAY PART SIZE" followed by SIZE bytes of puzzle input, e.g. "12 2 20384\n...".
+	// The answer is a single line: "ok TIME_NS RESULT", where TIME_NS is how long the solve took, or
+	// "error MESSAGE". Malformed requests, and inputs over 64 MiB, get an error and the connection is closed.
+	//
+	// Returns false if the socket cannot be set up. Otherwise it runs until the process is stopped.
+	bool run_server(std::string_view socket_path, std::size_t num_threads);
+}
\ No newline at end of file
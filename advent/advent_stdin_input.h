@@ -0,0 +1,10 @@
+#pragma once
+
+namespace advent
+{
+	// Solves one part of a day's puzzle for input piped to stdin, and prints the answer.
+	// Days that read their input a line at a time (see puzzle_solver::solve_stream) work through it as it arrives,
+	// holding only a chunk at a time; the rest are given all of it once it has been read.
+	// Returns false if there is no solver for that day and part, or it fails.
+	bool solve_from_stdin(int day, int part);
+}
\ No newline at end of file
@@ -1,32 +1,44 @@
 #pragma once
 
-#include <sstream>
 #include <string_view>
+#include <array>
+#include <cstddef>
 
 namespace advent
 {
-	namespace combine_inputs_internal
+	// Test input text built at compile time, so tests can refer to it from a constexpr table.
+	template <std::size_t SIZE>
+	struct static_input
 	{
-		inline std::string impl(std::string_view joiner, std::ostringstream& collector)
-		{
-			return collector.str();
-		}
+		std::array<char, SIZE> text{};
+		constexpr operator std::string_view() const noexcept { return std::string_view{ text.data(), text.size() }; }
+	};
 
-		template <typename...StringViews>
-		inline std::string impl(std::string_view joiner, std::ostringstream& collector, std::string_view next_string, StringViews...remaining)
-		{
-			collector << joiner << next_string;
-			return impl(joiner, collector,remaining...);
-		}
-	}
-
-	template <std::size_t NUM_NEWLINES, typename...StringViews>
-	inline std::string combine_inputs(std::string_view first_string, StringViews...remaining)
+	// Joins the inputs with NUM_NEWLINES newlines between each one.
+	template <std::size_t NUM_NEWLINES, std::size_t...SIZES>
+	constexpr auto combine_inputs(const char(&...inputs)[SIZES])
 	{
-		std::ostringstream collector;
-		std::string joiner(NUM_NEWLINES, '\n');
-		collector << first_string;
-		return combine_inputs_internal::impl(joiner, collector, remaining...);
+		// Each size includes the null terminator.
+		static_input<((SIZES - 1) + ...) + NUM_NEWLINES * (sizeof...(SIZES) - 1)> result;
+		std::size_t pos = 0;
+		bool first = true;
+		auto append = [&result, &pos, &first](std::string_view input)
+		{
+			if (!first)
+			{
+				for (std::size_t i = 0; i < NUM_NEWLINES; ++i)
+				{
+					result.text[pos++] = '\n';
+				}
+			}
+			for (char c : input)
+			{
+				result.text[pos++] = c;
+			}
+			first = false;
+		};
+		(append(std::string_view{ inputs, SIZES - 1 }), ...);
+		return result;
 	}
 }
 
@@ -34,7 +46,7 @@ namespace advent
 #define TEST_ONE_B "pqr3stu8vwx"
 #define TEST_ONE_C "a1b2c3d4e5f"
 #define TEST_ONE_D "treb7uchet"
-static const auto TEST_ONE_FILE_A = advent::combine_inputs<1>(TEST_ONE_A, TEST_ONE_B, TEST_ONE_C, TEST_ONE_D);
+constexpr auto TEST_ONE_FILE_A = advent::combine_inputs<1>(TEST_ONE_A, TEST_ONE_B, TEST_ONE_C, TEST_ONE_D);
 #define TEST_ONE_F "two1nine"
 #define TEST_ONE_G "eightwothree"
 #define TEST_ONE_H "abcone2threexyz"
@@ -42,24 +54,24 @@ static const auto TEST_ONE_FILE_A = advent::combine_inputs<1>(TEST_ONE_A, TEST_O
 #define TEST_ONE_J "4nineeightseven2"
 #define TEST_ONE_K "zoneight234"
 #define TEST_ONE_L "7pqrstsixteen"
-static const auto TEST_ONE_FILE_B = advent::combine_inputs<1>(TEST_ONE_F, TEST_ONE_G, TEST_ONE_H, TEST_ONE_I, TEST_ONE_J, TEST_ONE_K, TEST_ONE_L);
-
-constexpr const char* TEST_TWO_A = "Game 1: 3 blue, 4 red; 1 red, 2 green, 6 blue; 2 green";
-constexpr const char* TEST_TWO_B = "Game 2: 1 blue, 2 green; 3 green, 4 blue, 1 red; 1 green, 1 blue";
-constexpr const char* TEST_TWO_C = "Game 3: 8 green, 6 blue, 20 red; 5 blue, 4 red, 13 green; 5 green, 1 red";
-constexpr const char* TEST_TWO_D = "Game 4: 1 green, 3 red, 6 blue; 3 green, 6 red; 3 green, 15 blue, 14 red";
-constexpr const char* TEST_TWO_E = "Game 5: 6 red, 1 blue, 3 green; 2 blue, 1 red, 2 green";
-static const auto TEST_TWO_F = advent::combine_inputs<1>(TEST_TWO_A, TEST_TWO_B, TEST_TWO_C, TEST_TWO_D, TEST_TWO_E);
-
-constexpr const char* TEST_FOUR_A = "Card 1: 41 48 83 86 17 | 83 86  6 31 17  9 48 53";
-constexpr const char* TEST_FOUR_B = "Card 2 : 13 32 20 16 61 | 61 30 68 82 17 32 24 19";
-constexpr const char* TEST_FOUR_C = "Card 3 : 1 21 53 59 44 | 69 82 63 72 16 21 14  1";
-constexpr const char* TEST_FOUR_D = "Card 4 : 41 92 73 84 69 | 59 84 76 51 58  5 54 83";
-constexpr const char* TEST_FOUR_E = "Card 5 : 87 83 26 28 32 | 88 30 70 12 93 22 82 36";
-constexpr const char* TEST_FOUR_F = "Card 6 : 31 18 13 56 72 | 74 77 10 23 35 67 36 11";
-static const auto TEST_FOUR_G = advent::combine_inputs<1>(TEST_FOUR_A, TEST_FOUR_B, TEST_FOUR_C, TEST_FOUR_D, TEST_FOUR_E, TEST_FOUR_E);
-
-constexpr const char* TEST_FIVE_A =
+constexpr auto TEST_ONE_FILE_B = advent::combine_inputs<1>(TEST_ONE_F, TEST_ONE_G, TEST_ONE_H, TEST_ONE_I, TEST_ONE_J, TEST_ONE_K, TEST_ONE_L);
+
+constexpr const char TEST_TWO_A[] = "Game 1: 3 blue, 4 red; 1 red, 2 green, 6 blue; 2 green";
+constexpr const char TEST_TWO_B[] = "Game 2: 1 blue, 2 green; 3 green, 4 blue, 1 red; 1 green, 1 blue";
+constexpr const char TEST_TWO_C[] = "Game 3: 8 green, 6 blue, 20 red; 5 blue, 4 red, 13 green; 5 green, 1 red";
+constexpr const char TEST_TWO_D[] = "Game 4: 1 green, 3 red, 6 blue; 3 green, 6 red; 3 green, 15 blue, 14 red";
+constexpr const char TEST_TWO_E[] = "Game 5: 6 red, 1 blue, 3 green; 2 blue, 1 red, 2 green";
+constexpr auto TEST_TWO_F = advent::combine_inputs<1>(TEST_TWO_A, TEST_TWO_B, TEST_TWO_C, TEST_TWO_D, TEST_TWO_E);
+
+constexpr const char TEST_FOUR_A[] = "Card 1: 41 48 83 86 17 | 83 86  6 31 17  9 48 53";
+constexpr const char TEST_FOUR_B[] = "Card 2 : 13 32 20 16 61 | 61 30 68 82 17 32 24 19";
+constexpr const char TEST_FOUR_C[] = "Card 3 : 1 21 53 59 44 | 69 82 63 72 16 21 14  1";
+constexpr const char TEST_FOUR_D[] = "Card 4 : 41 92 73 84 69 | 59 84 76 51 58  5 54 83";
+constexpr const char TEST_FOUR_E[] = "Card 5 : 87 83 26 28 32 | 88 30 70 12 93 22 82 36";
+constexpr const char TEST_FOUR_F[] = "Card 6 : 31 18 13 56 72 | 74 77 10 23 35 67 36 11";
+constexpr auto TEST_FOUR_G = advent::combine_inputs<1>(TEST_FOUR_A, TEST_FOUR_B, TEST_FOUR_C, TEST_FOUR_D, TEST_FOUR_E, TEST_FOUR_E);
+
+constexpr const char TEST_FIVE_A[] =
 R"(seeds: 79 14 55 13
 
 seed-to-soil map:
@@ -104,9 +116,9 @@ humidity-to-location map:
 #define TEST_SEVEN_C "KK677 28"
 #define TEST_SEVEN_D "KTJJT 220"
 #define TEST_SEVEN_E "QQQJA 483"
-static const auto TEST_SEVEN_FILE_A = advent::combine_inputs<1>(TEST_SEVEN_A, TEST_SEVEN_B, TEST_SEVEN_C, TEST_SEVEN_D, TEST_SEVEN_E);
+constexpr auto TEST_SEVEN_FILE_A = advent::combine_inputs<1>(TEST_SEVEN_A, TEST_SEVEN_B, TEST_SEVEN_C, TEST_SEVEN_D, TEST_SEVEN_E);
 
-constexpr const char* TEST_EIGHT_A = 
+constexpr const char TEST_EIGHT_A[] = 
 R"(RL
 
 AAA = (BBB, CCC)
@@ -117,14 +129,14 @@ EEE = (EEE, EEE)
 GGG = (GGG, GGG)
 ZZZ = (ZZZ, ZZZ))";
 
-constexpr const char* TEST_EIGHT_B =
+constexpr const char TEST_EIGHT_B[] =
 R"(LLR
 
 AAA = (BBB, BBB)
 BBB = (AAA, ZZZ)
 ZZZ = (ZZZ, ZZZ))";
 
-constexpr const char* TEST_EIGHT_C =
+constexpr const char TEST_EIGHT_C[] =
 R"(LR
 
 11A = (11B, XXX)
@@ -139,37 +151,37 @@ XXX = (XXX, XXX))";
 #define TEST_NINE_A "0 3 6 9 12 15"
 #define TEST_NINE_B "1 3 6 10 15 21"
 #define TEST_NINE_C "10 13 16 21 30 45"
-static const auto TEST_NINE_D = advent::combine_inputs<1>(TEST_NINE_A, TEST_NINE_B, TEST_NINE_C);
+constexpr auto TEST_NINE_D = advent::combine_inputs<1>(TEST_NINE_A, TEST_NINE_B, TEST_NINE_C);
 
-constexpr const char* TEST_TEN_A =
+constexpr const char TEST_TEN_A[] =
 R"(.....
 .S-7.
 .|.|.
 .L-J.
 .....)";
 
-constexpr const char* TEST_TEN_B =
+constexpr const char TEST_TEN_B[] =
 R"(-L|F7
 7S-7|
 L|7||
 -L-J|
 L|-JF)";
 
-constexpr const char* TEST_TEN_C =
+constexpr const char TEST_TEN_C[] =
 R"(..F7.
 .FJ|.
 SJ.L7
 |F--J
 LJ...)";
 
-constexpr const char* TEST_TEN_D =
+constexpr const char TEST_TEN_D[] =
 R"(7-F7-
 .FJ|7
 SJLL7
 |F--J
 LJ.LJ)";
 
-constexpr const char* TEST_TEN_E =
+constexpr const char TEST_TEN_E[] =
 R"(...........
 .S-------7.
 .|F-----7|.
@@ -180,7 +192,7 @@ R"(...........
 .L--J.L--J.
 ...........)";
 
-constexpr const char* TEST_TEN_F =
+constexpr const char TEST_TEN_F[] =
 R"(.F----7F7F7F7F-7....
 .|F--7||||||||FJ....
 .||.FJ||||||||L7....
@@ -192,7 +204,7 @@ L--J.L7...LJS7F-7L7.
 ....FJL-7.||.||||...
 ....L---J.LJ.LJLJ...)";
 
-constexpr const char* TEST_TEN_G =
+constexpr const char TEST_TEN_G[] =
 R"(FF7FSF7F7F7F7F7F---7
 L|LJ||||||||||||F--J
 FL-7LJLJ||||||LJL-77
@@ -204,7 +216,7 @@ L---JF-JLJ.||-FJLJJ7
 L.L7LFJ|||||FJL7||LJ
 L7JLJL-JLJLJL--JLJ.L)";
 
-constexpr const char* TEST_TEN_H =
+constexpr const char TEST_TEN_H[] =
 R"(F-S
 |.|
 L-J)";
@@ -216,9 +228,9 @@ L-J)";
 #define TEST_TWELVE_E "????.######..#####. 1,6,5"
 #define TEST_TWELVE_F "?###???????? 3,2,1"
 
-static const auto TEST_TWELVE_G = advent::combine_inputs<1>(TEST_TWELVE_A, TEST_TWELVE_B, TEST_TWELVE_C, TEST_TWELVE_D, TEST_TWELVE_E, TEST_TWELVE_F);
+constexpr auto TEST_TWELVE_G = advent::combine_inputs<1>(TEST_TWELVE_A, TEST_TWELVE_B, TEST_TWELVE_C, TEST_TWELVE_D, TEST_TWELVE_E, TEST_TWELVE_F);
 
-constexpr const char* TEST_THIRTEEN_A =
+constexpr const char TEST_THIRTEEN_A[] =
 R"(#.##..##.
 ..#.##.#.
 ##......#
@@ -227,7 +239,7 @@ R"(#.##..##.
 ..##..##.
 #.#.##.#.)";
 
-constexpr const char* TEST_THIRTEEN_B =
+constexpr const char TEST_THIRTEEN_B[] =
 R"(#...##..#
 #....#..#
 ..##..###
@@ -236,9 +248,9 @@ R"(#...##..#
 ..##..###
 #....#..#)";
 
-static const auto TEST_THIRTEEN_C = advent::combine_inputs<2>(TEST_THIRTEEN_A, TEST_THIRTEEN_B);
+constexpr auto TEST_THIRTEEN_C = advent::combine_inputs<2>(TEST_THIRTEEN_A, TEST_THIRTEEN_B);
 
-constexpr const char* TEST_FOURTEEN_A =
+constexpr const char TEST_FOURTEEN_A[] =
 R"(O....#....
 O.OO#....#
 .....##...
@@ -250,9 +262,9 @@ O.#..O.#.#
 #....###..
 #OO..#....)";
 
-constexpr const char* TEST_FIFTEEN_A = "rn=1,cm-,qp=3,cm=2,qp-,pc=4,ot=9,ab=5,pc-,pc=6,ot=7";
+constexpr const char TEST_FIFTEEN_A[] = "rn=1,cm-,qp=3,cm=2,qp-,pc=4,ot=9,ab=5,pc-,pc=6,ot=7";
 
-constexpr const char* TEST_SIXTEEN_A =
+constexpr const char TEST_SIXTEEN_A[] =
 R"(.|...\....
 |.-.\.....
 .....|-...
@@ -264,7 +276,7 @@ R"(.|...\....
 .|....-|.\
 ..//.|....)";
 
-constexpr const char* TEST_SEVENTEEN_A =
+constexpr const char TEST_SEVENTEEN_A[] =
 R"(2413432311323
 3215453535623
 3255245654254
@@ -279,14 +291,14 @@ R"(2413432311323
 2546548887735
 4322674655533)";
 
-constexpr const char* TEST_SEVENTEEN_B =
+constexpr const char TEST_SEVENTEEN_B[] =
 R"(111111111111
 999999999991
 999999999991
 999999999991
 999999999991)";
 
-constexpr const char* TEST_EIGHTEEN_A =
+constexpr const char TEST_EIGHTEEN_A[] =
 R"(R 6 (#70c710)
 D 5 (#0dc571)
 L 2 (#5713f0)
@@ -302,7 +314,7 @@ U 3 (#a77fa3)
 L 2 (#015232)
 U 2 (#7a21e3))";
 
-constexpr const char* TEST_NINETEEN_A =
+constexpr const char TEST_NINETEEN_A[] =
 R"(px{a<2006:qkq,m>2090:A,rfg}
 pv{a>1716:R,A}
 lnx{m>1548:A,A}
@@ -321,21 +333,21 @@ hdj{m>838:A,pv}
 {x=2461,m=1339,a=466,s=291}
 {x=2127,m=1623,a=2188,s=1013})";
 
-constexpr const char* TEST_TWENTY_A =
+constexpr const char TEST_TWENTY_A[] =
 R"(broadcaster -> a, b, c
 %a -> b
 %b -> c
 %c -> inv
 &inv -> a)";
 
-constexpr const char* TEST_TWENTY_B =
+constexpr const char TEST_TWENTY_B[] =
 R"(broadcaster -> a
 %a -> inv, con
 &inv -> b
 %b -> con
 &con -> output)";
 
-constexpr const char* TEST_TWENTYONE_A =
+constexpr const char TEST_TWENTYONE_A[] =
 R"(...........
 .....###.#.
 .###.##..#.
@@ -348,7 +360,7 @@ R"(...........
 .##..##.##.
 ...........)";
 
-constexpr const char* TEST_TWENTYTWO_A =
+constexpr const char TEST_TWENTYTWO_A[] =
 R"(1,0,1~1,2,1
 0,0,2~2,0,2
 0,2,3~2,2,3
@@ -357,7 +369,7 @@ R"(1,0,1~1,2,1
 0,1,6~2,1,6
 1,1,8~1,1,9)";
 
-constexpr const char* TEST_TWENTYTHREE_A =
+constexpr const char TEST_TWENTYTHREE_A[] =
 R"(#.#####################
 #.......#########...###
 #######.#########.#.###
@@ -382,7 +394,7 @@ R"(#.#####################
 #.....###...###...#...#
 #####################.#)";
 
-constexpr const char* TEST_TWENTYFOUR_A =
+constexpr const char TEST_TWENTYFOUR_A[] =
 R"(19, 13, 30 @ -2,  1, -2
 18, 19, 22 @ -1, -1, -2
 20, 25, 34 @ -2, -2, -4
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <optional>
+#include <chrono>
+#include <functional>
+
+#include "advent_test_result.h"
+
+namespace advent
+{
+	// Whether run_isolated can use a separate process here (POSIX only).
+	bool can_isolate_tests() noexcept;
+
+	// Calls run_test in a forked child so a test that crashes or never finishes cannot take the rest of
+	// the run with it. The child's result and anything it wrote to std::cout are passed back through a pipe;
+	// the output is written to std::cout here. A child still running after timeout is killed and reported
+	// as test_status::timeout. A zero timeout waits forever. A child that dies any other way is reported as
+	// test_status::crash. Zones are not passed back.
+	// The child is a copy of this process with only the calling thread, so a lock held by another thread
+	// at the fork stays held in the child. Load what the test needs beforehand, and use a timeout if other
+	// threads are running.
+	// Must only be called if can_isolate_tests() is true.
+	test_result run_isolated(std::string_view name, const std::optional<std::string>& expected,
+		std::chrono::milliseconds timeout, const std::function<test_result()>& run_test);
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <string>
+#include <chrono>
+#include <optional>
+#include <cstddef>
+#include <cstdint>
+
+#include "advent_zones.h"
+
+// Result a test can give.
+enum class test_status : char
+{
+	pass,
+	fail,
+	unknown,
+	filtered,
+	timeout, // Only when tests run in their own process.
+	crash // Only when tests run in their own process.
+};
+
+// Timings from running a test repeatedly.
+struct benchmark_stats
+{
+	std::size_t num_runs = 0;
+	std::chrono::nanoseconds min{ 0 };
+	std::chrono::nanoseconds median{ 0 };
+	std::chrono::nanoseconds p95{ 0 };
+	std::chrono::nanoseconds mean{ 0 };
+	std::chrono::nanoseconds stddev{ 0 };
+	double allocations_per_run = 0.0;
+};
+
+// Hardware counters from a test's checked run. Any the platform could not provide are nullopt.
+struct perf_counter_values
+{
+	std::optional<std::uint64_t> cycles;
+	std::optional<std::uint64_t> instructions;
+	std::optional<std::uint64_t> l1d_misses;
+	std::optional<std::uint64_t> llc_misses;
+	std::optional<std::uint64_t> branch_misses;
+	bool any() const noexcept { return cycles || instructions || l1d_misses || llc_misses || branch_misses; }
+};
+
+// Heap use during a test's checked run, as seen by the global operator new.
+struct allocation_summary
+{
+	std::size_t num_allocations = 0;
+	std::size_t bytes_allocated = 0;
+	std::size_t peak_live_bytes = 0; // Above what was already live when the test started.
+};
+
+// Resident memory during a test's checked run. Measured for the whole process, so only
+// attributable to the test when tests run one at a time.
+struct memory_usage
+{
+	std::optional<std::size_t> peak_rss_bytes;
+	std::optional<std::size_t> rss_increase_bytes; // Peak minus what was resident when the test started.
+	bool exceeded_limit = false;
+};
+
+// Full results of a test.
+struct test_result
+{
+	std::string name;
+	std::string result;
+	std::string expected;
+	test_status status = test_status::unknown;
+	std::chrono::nanoseconds time_taken; // The median time when benchmarking.
+	std::optional<benchmark_stats> benchmark;
+	std::optional<perf_counter_values> counters;
+	std::optional<allocation_summary> allocations;
+	std::optional<advent::zone_trace> zones; // The test itself is the outermost zone.
+	std::optional<memory_usage> memory;
+};
\ No newline at end of file
@@ -1,61 +1,151 @@
 #pragma once
 
-#include <functional>
 #include <string>
 #include <string_view>
 #include <optional>
 #include <variant>
+#include <array>
+#include <algorithm>
+#include <concepts>
+#include <ranges>
+#include <iosfwd>
+#include <cstdint>
+#include <cstddef>
 
-using TestFunc = std::function<ResultType()>;
-using TestFuncWithArg = std::function<ResultType(std::istream&)>;
+// Everything here can be built at compile time, so the test table is a constexpr array with nothing to set up at startup.
+
+using TestFunc = ResultType(*)();
+using TestFuncWithArg = ResultType(*)(std::istream&);
 
 struct TestExecutable
 {
-	TestFunc func;
-	ResultType execute() { return func(); }
-	explicit TestExecutable(TestFunc func_) : func{func_}{}
+	TestFunc func = nullptr;
+	ResultType execute() const { return func(); }
 };
 
 struct TestWithArgExecutable
 {
-	TestFuncWithArg func;
-	std::string arg;
-	ResultType execute();
-	TestWithArgExecutable(TestFuncWithArg func_, std::string arg_) : func(func_) , arg(std::move(arg_)){}
+	TestFuncWithArg func = nullptr;
+	std::string_view arg;
+	ResultType execute() const;
 };
 
 using Test = std::variant<TestExecutable,TestWithArgExecutable>;
 
+// A type to use to indicate the result is not known yet. Using this in a verification test
+// will run the test and report the result, but will count as neither pass nor failure.
+struct Dummy {};
+static constexpr Dummy dummy;
+
+// The result a test should give: a number, some text or, for dummy, nothing.
+class expected_value
+{
+	std::optional<std::int64_t> m_number;
+	std::optional<std::string_view> m_text;
+public:
+	constexpr expected_value(Dummy) noexcept {}
+	template <std::integral T>
+	constexpr expected_value(T number) noexcept : m_number{ static_cast<std::int64_t>(number) } {}
+	constexpr expected_value(const char* text) noexcept : m_text{ text } {}
+
+	constexpr bool has_value() const noexcept { return m_number.has_value() || m_text.has_value(); }
+
+	// As it would be printed by a test that got it right.
+	std::optional<std::string> get() const
+	{
+		if (m_number.has_value()) return std::to_string(*m_number);
+		if (m_text.has_value()) return std::string{ *m_text };
+		return std::nullopt;
+	}
+};
+
 // This describes a test to run.
 struct verification_test
 {
-	std::string name;
+	std::string_view name; // Always a whole string literal, so name.data() is null-terminated.
 	Test test_func;
-	std::optional<std::string> expected_result;
-	verification_test(std::string name_, TestFunc func) : verification_test{ std::move(name_), func, std::nullopt }{}
-	verification_test(std::string name_, TestFunc func, std::string result) : verification_test{std::move(name_), func, std::optional<std::string>{std::move(result)} }{}
-	verification_test(std::string name_, TestFuncWithArg func, std::string arg) : verification_test{ std::move(name_), func, std::move(arg), std::nullopt } {}
-	verification_test(std::string name_, TestFuncWithArg func, std::string arg, std::string result) : verification_test{ std::move(name_), func, std::move(arg), std::optional<std::string>{std::move(result)} } {}
-private:
-	verification_test(std::string n, TestFunc t, std::optional<std::string> r) : name(std::move(n)),test_func(TestExecutable{t}),expected_result(std::move(r)){} 
-	verification_test(std::string n, TestFuncWithArg t, std::string arg, std::optional<std::string> r) : name(std::move(n)),test_func(TestWithArgExecutable{t , std::move(arg)}),expected_result(std::move(r)){} 
+	expected_value expected_result = dummy;
+	int day = 0;
+	int part = 0; // 0 for tests that are not for one part, like testcase_eleven.
 };
 
-// A type to use to indicate the result is not known yet. Using this in a verification test
-// will run the test and report the result, but will count as neither pass nor failure.
-struct Dummy {};
-static constexpr Dummy dummy;
+namespace advent::testcase_setup_internal
+{
+	constexpr std::string_view DAY_NAMES[] = {
+		"one", "two", "three", "four", "five", "six", "seven", "eight", "nine", "ten",
+		"eleven", "twelve", "thirteen", "fourteen", "fifteen", "sixteen", "seventeen", "eighteen", "nineteen", "twenty",
+		"twentyone", "twentytwo", "twentythree", "twentyfour", "twentyfive"
+	};
+
+	// Test functions are named like "testcase_twelve_p1" or "advent_twelve_p2", so the day is the word after
+	// the first underscore. Returns 0 for names that do not follow the pattern.
+	constexpr int get_day(std::string_view name)
+	{
+		const auto start = name.find('_');
+		if (start == std::string_view::npos) return 0;
+		name.remove_prefix(start + 1);
+		name = name.substr(0, name.find_first_of("_<("));
+		const auto find_result = std::ranges::find(DAY_NAMES, name);
+		return find_result != std::end(DAY_NAMES) ? static_cast<int>(find_result - std::begin(DAY_NAMES)) + 1 : 0;
+	}
+
+	// The digit after "_p" in the function name.
+	constexpr int get_part(std::string_view name)
+	{
+		name = name.substr(0, name.find('('));
+		for (auto pos = name.find("_p"); pos != std::string_view::npos; pos = name.find("_p", pos + 1))
+		{
+			if (pos + 2 < name.size() && (name[pos + 2] == '1' || name[pos + 2] == '2'))
+			{
+				return name[pos + 2] - '0';
+			}
+		}
+		return 0;
+	}
+}
 
-verification_test make_test(std::string name, TestFunc func, int64_t result);
-verification_test make_test(std::string name, TestFunc func, std::string result);
-verification_test make_test(std::string name, TestFunc func, Dummy);
+constexpr verification_test make_test(std::string_view name, TestFunc func, expected_value result)
+{
+	using namespace advent::testcase_setup_internal;
+	return verification_test{ name, TestExecutable{ func }, result, get_day(name), get_part(name) };
+}
+
+constexpr verification_test make_test(std::string_view name, TestFuncWithArg func, expected_value result, std::string_view arg)
+{
+	using namespace advent::testcase_setup_internal;
+	return verification_test{ name, TestWithArgExecutable{ func, arg }, result, get_day(name), get_part(name) };
+}
 
-verification_test make_test(std::string name, TestFuncWithArg func, int64_t result, std::string arg);
-verification_test make_test(std::string name, TestFuncWithArg func, std::string result, std::string arg);
-verification_test make_test(std::string name, TestFuncWithArg func, Dummy, std::string arg);
+// Build with ADVENT_DAYS defined as a list of days (e.g. -DADVENT_DAYS=6,9) to leave every other day out of the
+// program. Their solutions are then never referenced, so their files do not need to be compiled or linked.
+constexpr bool is_day_selected(int day) noexcept
+{
+#ifdef ADVENT_DAYS
+	constexpr int selected_days[] = { ADVENT_DAYS };
+	return std::ranges::find(selected_days, day) != std::end(selected_days);
+#else
+	return day > 0;
+#endif
+}
+
+// The elements of all that pred is true for, in order. NUM_SELECTED must be how many there are.
+template <std::size_t NUM_SELECTED, std::ranges::input_range Range, typename Pred>
+constexpr auto select_if(const Range& all, Pred pred)
+{
+	using T = std::ranges::range_value_t<Range>;
+	std::array<T, NUM_SELECTED> result{};
+	auto out = begin(result);
+	for (const T& item : all)
+	{
+		if (!pred(item)) continue;
+		if (out == end(result)) throw "NUM_SELECTED is too small"; // Stops compilation.
+		*out++ = item;
+	}
+	return result;
+}
 
-#define ARG(func_name) std::string{ #func_name },func_name
-#define ARG_WITH_PARAM(func_name,param) std::string{ #func_name "("  #param ")"  }, func_name
+#define ARG(func_name) #func_name,func_name
+#define ARG_WITH_PARAM(func_name,param) #func_name "("  #param ")", func_name
 #define TESTCASE(func_name,expected_result) make_test(ARG(func_name),expected_result)
 #define TESTCASE_WITH_ARG(func_name,arg,expected_result) make_test(ARG_WITH_PARAM(func_name,arg),expected_result,arg)
 #define FUNC_NAME(day_num,part_num) advent_ ## day_num ## _p ## part_num
@@ -6,6 +6,7 @@
 #include <ranges>
 
 using ResultType = std::variant<std::string, int64_t, uint64_t>;
+std::string to_string(const ResultType& rt);
 enum class AdventDay
 {
 	one, two
@@ -6,18 +6,43 @@
 #include <string>
 #include <string_view>
 #include <iostream>
-#include <filesystem>
 
 #include "advent_assert.h"
+#include "advent_input_cache.h"
+#include "advent_zones.h"
+#include "advent_arena.h"
+#include "../utils/view_istream.h"
 
 namespace advent
 {
-	inline std::ifstream open_input(const std::string& filename)
+	namespace input_internal
 	{
-		auto result = std::ifstream{ filename };
-		AdventCheck(result.is_open());
+		inline thread_local const std::string_view* t_puzzle_input = nullptr;
+	}
+
+	// While one of these is alive, get_puzzle_input and open_puzzle_input on this thread give this text
+	// instead of the day's input file, so the harness can run a day's solution on any input.
+	class scoped_puzzle_input
+	{
+		std::string_view m_input;
+		const std::string_view* m_previous;
+	public:
+		explicit scoped_puzzle_input(std::string_view input) noexcept : m_input{ input }, m_previous{ input_internal::t_puzzle_input }
+		{
+			input_internal::t_puzzle_input = &m_input;
+		}
+		~scoped_puzzle_input() noexcept { input_internal::t_puzzle_input = m_previous; }
+		scoped_puzzle_input(const scoped_puzzle_input&) = delete;
+		scoped_puzzle_input& operator=(const scoped_puzzle_input&) = delete;
+	};
+
+	// Inputs come from a process-wide cache of memory-mapped files, so opening
+	// the same file again (e.g. for part 2, or when benchmarking) does no file I/O.
+	inline std::string_view get_input(const std::string& filename)
+	{
+		const std::string_view result = get_input_view(filename);
 #ifndef NDEBUG
-		if (std::filesystem::file_size(filename) <= 0)
+		if (result.empty())
 		{
 			std::cerr << "\nWARNING! File '" << filename << "' is empty.";
 		}
@@ -25,17 +50,41 @@ namespace advent
 		return result;
 	}
 
-	inline std::ifstream open_puzzle_input(int day)
+	inline std::string get_puzzle_input_filename(int day)
 	{
 		std::ostringstream name;
 		name << "advent" << day << "/advent" << day << ".txt";
-		return open_input(name.str());
+		return name.str();
 	}
 
-	inline std::ifstream open_testcase_input(int day, char id)
+	inline std::string get_testcase_input_filename(int day, char id)
 	{
 		std::ostringstream name;
 		name << "advent" << day << "/testcase_" << id << ".txt";
-		return open_input(name.str());
+		return name.str();
+	}
+
+	inline std::string_view get_puzzle_input(int day)
+	{
+		if (input_internal::t_puzzle_input != nullptr)
+		{
+			return *input_internal::t_puzzle_input;
+		}
+		return get_input(get_puzzle_input_filename(day));
+	}
+
+	inline utils::view_istream open_input(const std::string& filename)
+	{
+		return utils::view_istream{ get_input(filename) };
+	}
+
+	inline utils::view_istream open_puzzle_input(int day)
+	{
+		return utils::view_istream{ get_puzzle_input(day) };
+	}
+
+	inline utils::view_istream open_testcase_input(int day, char id)
+	{
+		return open_input(get_testcase_input_filename(day, id));
 	}
 }
\ No newline at end of file
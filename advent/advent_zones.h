@@ -0,0 +1,122 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+
+// Named, nestable timing zones that solvers can put around phases of their work:
+//     AdventZone("parse");
+// times from that line to the end of the enclosing scope. Zones are only recorded while the harness
+// is collecting them (--zones or --trace), and cost one thread_local load otherwise.
+// Define ADVENT_ZONES to 0 to compile them out completely.
+#ifndef ADVENT_ZONES
+#define ADVENT_ZONES 1
+#endif
+
+#define InternalAdventZoneConcatImpl(a,b) a##b
+#define InternalAdventZoneConcat(a,b) InternalAdventZoneConcatImpl(a,b)
+
+#if ADVENT_ZONES
+#define AdventZone(name) const advent::scoped_zone InternalAdventZoneConcat(advent_zone_,__LINE__){ name }
+#else
+#define AdventZone(name) do{}while(false)
+#endif
+
+namespace advent
+{
+	using zone_clock = std::chrono::steady_clock;
+
+	struct zone_record
+	{
+		const char* name = nullptr; // Must outlive the recorder. String literals are ideal.
+		zone_clock::time_point start;
+		std::chrono::nanoseconds duration{ 0 };
+		std::uint32_t depth = 0;
+	};
+
+	// Everything recorded for one test.
+	struct zone_trace
+	{
+		std::uint32_t thread_index = 0;
+		std::vector<zone_record> records;
+	};
+
+	class zone_recorder;
+
+	namespace zones_internal
+	{
+		inline thread_local zone_recorder* t_recorder = nullptr;
+
+		inline std::uint32_t get_thread_index() noexcept
+		{
+			static std::atomic<std::uint32_t> next_index{ 0 };
+			static thread_local const std::uint32_t index = next_index++;
+			return index;
+		}
+	}
+
+	// Collects the zones entered on one thread, in the order they were entered.
+	class zone_recorder
+	{
+		std::vector<zone_record> m_records;
+		std::uint32_t m_depth = 0;
+	public:
+		// Reserving up front keeps the recorder's own allocations out of most tests' allocation counts.
+		zone_recorder() { m_records.reserve(256); }
+
+		std::size_t open(const char* name)
+		{
+			m_records.push_back(zone_record{ name, zone_clock::now(), std::chrono::nanoseconds{ 0 }, m_depth++ });
+			return m_records.size() - 1;
+		}
+
+		void close(std::size_t idx) noexcept
+		{
+			zone_record& record = m_records[idx];
+			record.duration = zone_clock::now() - record.start;
+			--m_depth;
+		}
+
+		const std::vector<zone_record>& records() const noexcept { return m_records; }
+
+		// Call on the thread that did the recording.
+		zone_trace take_trace() noexcept { return zone_trace{ zones_internal::get_thread_index(), std::move(m_records) }; }
+	};
+
+	// Sends zones entered on this thread to the recorder (or nowhere, if it is null) until destroyed.
+	class scoped_zone_recording
+	{
+		zone_recorder* m_previous;
+	public:
+		explicit scoped_zone_recording(zone_recorder* recorder) noexcept : m_previous{ zones_internal::t_recorder } { zones_internal::t_recorder = recorder; }
+		~scoped_zone_recording() noexcept { zones_internal::t_recorder = m_previous; }
+		scoped_zone_recording(const scoped_zone_recording&) = delete;
+		scoped_zone_recording& operator=(const scoped_zone_recording&) = delete;
+	};
+
+	// Use through AdventZone.
+	class scoped_zone
+	{
+		zone_recorder* m_recorder;
+		std::size_t m_idx = 0;
+	public:
+		explicit scoped_zone(const char* name) : m_recorder{ zones_internal::t_recorder }
+		{
+			if (m_recorder != nullptr) [[unlikely]]
+			{
+				m_idx = m_recorder->open(name);
+			}
+		}
+		~scoped_zone() noexcept
+		{
+			if (m_recorder != nullptr) [[unlikely]]
+			{
+				m_recorder->close(m_idx);
+			}
+		}
+		scoped_zone(const scoped_zone&) = delete;
+		scoped_zone& operator=(const scoped_zone&) = delete;
+	};
+}
\ No newline at end of file
@@ -57,12 +57,14 @@ namespace
 				{
 					const Galaxy loc{x , max_y};
 					result.push_back(loc);
-					if(!x_vals_with_galaxy.contains(x)) x_vals_with_galaxy.push_back(x);
-					if(!y_vals_with_galaxy.contains(max_y)) y_vals_with_galaxy.push_back(max_y);
+					x_vals_with_galaxy.push_back(x);
+					y_vals_with_galaxy.push_back(max_y);
 				}
 			}
 			++max_y;
 		}
+		x_vals_with_galaxy.unique();
+		y_vals_with_galaxy.unique();
 		
 		CoordSet empty_x_coords;
 		CoordSet empty_y_coords;
@@ -24,26 +24,27 @@ namespace
 #include "grid.h"
 #include "range_contains.h"
 #include "enums.h"
-#include "swap_remove.h"
 #include "small_vector.h"
+#include "state_space_dijkstra.h"
 #include "int_range.h"
 
-#include <algorithm>
-#include <set>
+#include <optional>
+#include <utility>
 
 namespace
 {
 	using Tile = uint8_t;
-	using Grid = utils::grid<Tile>;
+	using Grid = utils::grid<Tile, advent::arena_allocator<Tile>>;
 
 	Grid parse_grid(std::istream& input)
 	{
+		AdventZone("parse");
 		auto parse_char = [](char c)
 		{
 			AdventCheck(utils::range_contains_inc(c, '1','9'));
 			return static_cast<Tile>(c - '0');
 		};
-		return utils::grid_helpers::build(input, parse_char);
+		return utils::grid_helpers::build(input, parse_char, advent::get_arena_allocator<Tile>());
 	}
 
 	struct PathResult
@@ -64,82 +65,35 @@ namespace
 			start_pos
 		};
 
-		struct NodeBase
-		{
-			utils::coords location;
-			EntryType entry_type;
-			auto operator<=>(const NodeBase&) const noexcept = default;
-		};
-
-		struct Node : NodeBase
-		{
-			std::size_t path_cost;
-			std::size_t plus_heuristic;
-		};
+		// A state is a location and the way we entered it. There's one extra state for the start,
+		// which is the only place we can go in any direction from.
+		const utils::coords grid_size = grid.get_max_point();
+		const std::size_t num_cells = grid.size();
+		const std::size_t start_state = 2 * num_cells;
 
-		auto sort_by_comparer = [](const Node& left, const Node& right, const auto& transform_fn)
+		auto encode = [&grid_size](const utils::coords& location, EntryType entry)
 		{
-			return transform_fn(left) <=> transform_fn(right);
+			AdventCheck(entry != EntryType::start_pos);
+			const std::size_t cell = static_cast<std::size_t>(location.y * grid_size.x + location.x);
+			return 2 * cell + static_cast<std::size_t>(entry);
 		};
 
-		auto sort_by_heuristic = [&sort_by_comparer](const Node& left, const Node& right)
+		auto decode = [&grid_size, &start_point, start_state](std::size_t state)
 		{
-			return sort_by_comparer(left,right,[](const Node& n){return std::pair{n.plus_heuristic,n.path_cost}; }) == std::weak_ordering::less;
-		};
-
-		auto sort_by_location = [&sort_by_comparer](const Node& left, const Node& right)
-		{
-			return sort_by_comparer(left, right, [](const Node& n) {return std::pair{ n.location,n.entry_type }; }) == std::weak_ordering::equivalent;
-		};
-
-		auto make_node = [&end_point](const utils::coords& point, EntryType entry, std::size_t current_cost)
-		{
-			Node result;
-			result.location = point;
-			result.entry_type = entry;
-			result.path_cost = current_cost;
-			result.plus_heuristic = current_cost + static_cast<std::size_t>(point.manhatten_distance(end_point));
-			return result;
-		};
-
-		auto make_result = [](const Node& node)
-		{
-			PathResult result;
-			result.path_cost = node.path_cost;
-			return result;
-		};
-
-		utils::small_vector<Node,1> nodes_to_check;
-		nodes_to_check.reserve(2 * grid.size());
-
-		std::set<NodeBase> checked_nodes;
-		//checked_nodes.reserve(2 * grid.size());
-
-		nodes_to_check.push_back( make_node(start_point,EntryType::start_pos, 0u) );
-
-		while(!nodes_to_check.empty())
-		{
-			const auto min_node_it = std::min_element(begin(nodes_to_check), end(nodes_to_check), sort_by_heuristic); // TODO switch to ranges
-			const Node node = *min_node_it;
-			utils::swap_remove(nodes_to_check,min_node_it);
-
-			AdventCheck(grid.is_on_grid(node.location));
-
-			if(node.location == end_point)
-			{
-				return make_result(node);
-			}
-
-			const auto find_previous_result = checked_nodes.find(node);
-			if(find_previous_result != end(checked_nodes))
+			if (state == start_state)
 			{
-				// We already checked this one.
-				continue;
+				return std::pair{ start_point, EntryType::start_pos };
 			}
+			const int cell = static_cast<int>(state / 2);
+			return std::pair{ utils::coords{ cell % grid_size.x, cell / grid_size.x }, static_cast<EntryType>(state % 2) };
+		};
 
-			checked_nodes.insert(find_previous_result, node);
+		auto get_next_states = [&](std::size_t state, auto& add_next)
+		{
+			const auto [location, entry] = decode(state);
+			AdventCheck(grid.is_on_grid(location));
 
-			const utils::small_vector<utils::direction,4> next_directions = [entry = node.entry_type]()
+			const utils::small_vector<utils::direction,4> next_directions = [entry]()
 			{
 				utils::small_vector<utils::direction,4> result;
 				switch(entry)
@@ -163,28 +117,41 @@ namespace
 			for(utils::direction dir : next_directions)
 			{
 				const EntryType et = utils::is_vertical(dir) ? EntryType::vertical : EntryType::horizontal;
-				std::size_t running_cost = node.path_cost;
+				std::size_t running_cost = 0;
 
 				for(int offset : utils::int_range{1,max_straight_line_path+1})
 				{
-					const utils::coords target_coords = node.location + offset * utils::coords::dir(dir);
+					const utils::coords target_coords = location + offset * utils::coords::dir(dir);
 					if(!grid.is_on_grid(target_coords)) break;
 
 					running_cost += grid.at(target_coords);
 					if(offset >= min_straight_line_path)
 					{
-						nodes_to_check.push_back(make_node(target_coords,et,running_cost));
+						add_next(encode(target_coords,et),running_cost);
 					}
 				}
 			}
-		}
-		AdventUnreachable();
-		return PathResult{};
+		};
+
+		auto is_end_state = [&decode, &end_point](std::size_t state)
+		{
+			return decode(state).first == end_point;
+		};
+
+		utils::state_space_dijkstra search{ start_state + 1 };
+		search.add_start(start_state);
+		const std::optional<std::size_t> end_state = search.run(is_end_state, get_next_states);
+		AdventCheck(end_state.has_value());
+
+		PathResult result;
+		result.path_cost = search.get_cost(*end_state);
+		return result;
 	}
 
 	std::size_t solve_generic(std::istream& input, int min_path, int max_path)
 	{
 		const Grid grid = parse_grid(input);
+		AdventZone("solve");
 		const PathResult path_result = get_path(grid, grid.top_left(), grid.bottom_right(), min_path, max_path);
 		return path_result.path_cost;
 	}
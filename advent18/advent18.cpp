@@ -22,7 +22,7 @@ namespace
 }
 
 #include "coords.h"
-#include "sorted_vector.h"
+#include "flat_hash_set.h"
 #include "to_value.h"
 #include "coords_iterators.h"
 #include "parse_utils.h"
@@ -36,7 +36,7 @@ namespace
 	using Coords = utils::coords;
 	using Dir = utils::direction;
 
-	using PointCloud = utils::sorted_vector<Coords>;
+	using PointCloud = utils::flat_hash_set<Coords>;
 
 	Dir to_direction(char c)
 	{
@@ -115,6 +115,7 @@ namespace
 	template <AdventDay day>
 	ParseResult parse_input(std::istream& input)
 	{
+		AdventZone("parse");
 		ParseResult result;
 		Coords current_point{0,0};
 		for(std::string_view line : utils::istream_line_range{input})
@@ -163,6 +164,7 @@ namespace
 	std::size_t solve_generic(std::istream& input)
 	{
 		const ParseResult parse_result = parse_input<day>(input);
+		AdventZone("solve");
 		const Coords bottom_left_border = parse_result.bottom_left - Coords{ 1,1 };
 		const Coords top_right_border = parse_result.top_right + Coords{ 1,1 };
 		const PointCloud outside = flood_fill(bottom_left_border, top_right_border, parse_result.points);
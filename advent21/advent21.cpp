@@ -23,14 +23,14 @@ namespace
 
 #include "coords.h"
 #include "int_range.h"
-#include "sorted_vector.h"
+#include "bit_grid.h"
 #include "istream_line_iterator.h"
 
 namespace
 {
 	using Coords = utils::coords;
 
-	using PointCloud = utils::sorted_vector<Coords>;
+	using PointCloud = utils::bit_grid;
 
 	struct ParseResult
 	{
@@ -44,11 +44,22 @@ namespace
 
 	ParseResult parse_input(std::istream& input)
 	{
+		AdventZone("parse");
 		ParseResult result;
-		result.garden_plots.reserve(131 * 131);
 		Coords current{ 0,0 };
 		for (std::string_view line : utils::istream_line_range{ input })
 		{
+			// Inputs usually end with a newline, which gives an empty last line.
+			if (line.empty())
+			{
+				continue;
+			}
+			if (current.y == 0)
+			{
+				result.garden_plots = PointCloud{ static_cast<int>(line.size()), 0 };
+			}
+			AdventCheck(static_cast<int>(line.size()) == result.garden_plots.width());
+			result.garden_plots.append_row();
 			for (char c : line)
 			{
 				switch (c)
@@ -59,7 +70,7 @@ namespace
 					result.start_point = current;
 					//[[fallthrough]]
 				case PLOT:
-					result.garden_plots.push_back(current);
+					result.garden_plots.set(current);
 					break;
 				default:
 					AdventUnreachable();
@@ -75,27 +86,23 @@ namespace
 
 	PointCloud get_next_steps(const PointCloud& current_places, const PointCloud& plots)
 	{
-		PointCloud result;
-		result.reserve(4 * current_places.size());
-		for (const Coords& c : current_places)
-		{
-			AdventCheck(plots.contains(c));
-			stdr::copy_if(c.neighbours(), std::back_inserter(result), [&plots](const Coords& n) {return plots.contains(n); });
-		}
-		result.unique();
+		PointCloud result = current_places.neighbours();
+		result &= plots;
 		return result;
 	}
 
 	std::size_t solve_p1(std::istream& input, int num_steps)
 	{
 		const ParseResult parse_result = parse_input(input);
-		PointCloud possible_plots{ parse_result.start_point };
+		AdventZone("solve");
+		PointCloud possible_plots{ parse_result.garden_plots.get_max_point() };
+		possible_plots.set(parse_result.start_point);
 		for (auto i : utils::int_range{ num_steps })
 		{
 			PointCloud next = get_next_steps(possible_plots, parse_result.garden_plots);
 			possible_plots = std::move(next);
 		}
-		return possible_plots.size();
+		return possible_plots.count();
 	}
 }
 
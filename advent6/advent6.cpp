@@ -42,6 +42,7 @@ namespace
 
 	RaceList parse_input_p1(std::istream& input)
 	{
+		AdventZone("parse");
 		RaceList result;
 		std::string current_line;
 		std::getline(input,current_line);
@@ -69,6 +70,7 @@ namespace
 
 	RaceDetails parse_input_p2(std::istream& input)
 	{
+		AdventZone("parse");
 		auto add_digit = [](int64_t total, char c)
 		{
 			return std::isdigit(c) ? (10 * total + c - '0') : total;
@@ -134,6 +136,7 @@ namespace
 	int64_t solve_p1(std::istream& input)
 	{
 		const RaceList rl = parse_input_p1(input);
+		AdventZone("solve");
 		return solve_p1(rl);
 	}
 }
@@ -143,6 +146,7 @@ namespace
 	int64_t solve_p2(std::istream& input)
 	{
 		const RaceDetails rd = parse_input_p2(input);
+		AdventZone("solve");
 		return get_num_winning_presses(rd);
 	}
 }
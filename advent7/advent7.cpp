@@ -217,16 +217,16 @@ namespace
 	}
 
 	template <AdventDay DAY>
-	int solve_generic(std::istream& input)
+	int64_t solve_generic(std::istream& input)
 	{
 		const HandsMap hm = parse_input<DAY>(input);
 		auto acc_fn = [&hm](std::size_t idx)
 		{
-			const int multiplier = static_cast<int>(idx) + 1;
+			const int64_t multiplier = static_cast<int64_t>(idx) + 1;
 			return multiplier * hm[idx].second;
 		};
 		const auto idx_range = utils::int_range{ hm.size() };
-		const auto result = std::transform_reduce(begin(idx_range), end(idx_range), 0, std::plus<int>{}, acc_fn);
+		const auto result = std::transform_reduce(begin(idx_range), end(idx_range), int64_t{ 0 }, std::plus<int64_t>{}, acc_fn);
 		return result;
 	}
 
@@ -241,12 +241,12 @@ namespace
 		return to_string(type);
 	}
 
-	int solve_p1(std::istream& input)
+	int64_t solve_p1(std::istream& input)
 	{
 		return solve_generic<AdventDay::one>(input);
 	}
 
-	int solve_p2(std::istream& input)
+	int64_t solve_p2(std::istream& input)
 	{
 		return solve_generic<AdventDay::two>(input);
 	}
@@ -27,9 +27,9 @@ namespace
 
 #include "range_contains.h"
 #include "sorted_vector.h"
+#include "frozen_flat_map.h"
 #include "parse_utils.h"
 #include "istream_line_iterator.h"
-#include "transform_if.h"
 #include "int_range.h"
 
 namespace
@@ -157,7 +157,9 @@ namespace
 	struct Description
 	{
 		DirectionList direction_list;
-		NodeMap node_map;
+
+		// The walks do a lookup per step, so this is frozen into a layout built for lookups.
+		utils::frozen_flat_map<NodeId, Junction> node_map;
 	};
 
 	Description parse_input(std::istream& input, std::string_view start_node_suffix, std::string_view end_node_suffix)
@@ -173,7 +175,7 @@ namespace
 			AdventCheck(line.empty());
 		}
 
-		result.node_map = parse_nodes(input, start_node_suffix, end_node_suffix);
+		result.node_map = utils::frozen_flat_map{ parse_nodes(input, start_node_suffix, end_node_suffix) };
 		return result;
 	}
 
@@ -247,11 +249,10 @@ namespace
 		SmallNodeList start_nodes;
 		SmallNodeList end_nodes;
 		
-		auto jn_to_node = [](const std::pair<NodeId, Junction>& n) { return n.first; };
 		auto keep_start = [](NodeId n) { return n.is_path_start(); };
 		auto keep_end = [](NodeId n) { return n.is_path_end(); };
-		utils::ranges::transform_if_post(desc.node_map, std::back_inserter(start_nodes), jn_to_node, keep_start);
-		utils::ranges::transform_if_post(desc.node_map, std::back_inserter(end_nodes), jn_to_node, keep_end);
+		stdr::copy_if(desc.node_map.keys(), std::back_inserter(start_nodes), keep_start);
+		stdr::copy_if(desc.node_map.keys(), std::back_inserter(end_nodes), keep_end);
 
 		auto node_to_path = [&desc,&end_nodes](NodeId start)
 			{
@@ -11,17 +11,46 @@ int main(int argc, char** argv)
 	// and advent_eighteen_p2() (as well as any other test functions with "eighteen"
 	// in the function name.
 	// Leave blank to run everything.
-	std::vector<std::string_view> filters;
-	for(int i=1;i<argc;++i)
+	// Options:
+	//   -j N                     Run N tests at once (0 for one per hardware thread).
+	//   --bench N                Time each test N times and report statistics.
+	//   --bench-time MS          Keep timing each test until MS milliseconds have been spent.
+	//   --warmup N               Untimed runs before benchmarking.
+	//   --export FILE            Save results as JSON (or CSV if FILE ends in ".csv").
+	//   --baseline FILE          Compare timings against a saved results file, and list tests whose status changed.
+	//   --regression-threshold P Percentage slowdown that counts as a regression (default 10).
+	//   --regression-floor US    Ignore slowdowns smaller than this many microseconds (default 100).
+	//   --perf                   Report CPU counters (cycles, instructions, cache and branch misses) per test. Linux only.
+	//   --alloc                  Report allocations, bytes allocated and peak live heap bytes per test.
+	//   --zones                  Report the time spent in each AdventZone (e.g. parsing and solving) per test.
+	//   --trace FILE             Save every test's zones as a Chrome trace JSON file.
+	//   --mem                    Report peak resident memory per test (use with -j 1).
+	//   --mem-limit MB           Fail tests that use more than MB MiB of memory, stopping their heap allocations there.
+	//   --sweep N                Instead of the tests, time solvers on generated inputs from 1 to N times puzzle size
+	//                            and estimate how their time grows.
+	//   --seed N                 Seed for the generated inputs (default 1).
+	//   --isolate                Run each test in its own process, so a crash only fails that test. Not on Windows.
+	//                            With -j other than 1 it needs --timeout, as a forked test can hang on a lock.
+	//   --timeout MS             Kill tests that take longer than MS milliseconds (implies --isolate).
+	//   --serve PATH             Instead of the tests, answer puzzle requests on a Unix domain socket at PATH until stopped,
+	//                            solving -j N of them at once. See advent/advent_server.h for the protocol.
+	//   --batch PATH --day N     Instead of the tests, solve day N for every input file in the directory or manifest PATH,
+	//                            using the -j threads, and report the throughput.
+	//   --stdin --day N --part P Instead of the tests, solve part P of day N for input piped in. Line-based days work
+	//                            through the input as it arrives.
+	//   --part P                 Only solve part P with --batch.
+	//   --batch-queue N          Most batch inputs to hold in memory at once (default twice the -j count).
+	const std::optional<verify_options> options = parse_verify_options(argc, argv);
+	if(!options.has_value())
 	{
-		filters.push_back(argv[i]);
+		return 1;
 	}
 
-	verify_all(filters);
+	const bool success = verify_all(*options);
 
 #ifndef WIN32
 	std::cout << "Program finished. Press any key to continue.";
 	std::cin.get();
 #endif
-	return 0;
+	return success ? 0 : 1;
 }
\ No newline at end of file
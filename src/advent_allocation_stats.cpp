@@ -0,0 +1,177 @@
+#include <cstdlib>
+#include <new>
+#include <algorithm>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#endif
+
+#include "../advent/advent_allocation_stats.h"
+
+// Replaces the global allocation functions so the harness can see how much each test uses the heap.
+// The array and nothrow forms forward to these by default, so only the basic and aligned forms are needed,
+// plus the sized deletes, which would otherwise go straight to the library's versions.
+// Live bytes are measured with the platform's "usable size" query, so allocation and deallocation
+// agree on the size without storing it. Where there is no such query live bytes are not tracked.
+
+namespace
+{
+	thread_local advent::allocation_stats t_stats;
+	thread_local std::size_t t_heap_limit = 0;
+
+	void check_heap_limit(std::size_t size)
+	{
+		if (t_heap_limit != 0 && t_stats.live_bytes + static_cast<std::ptrdiff_t>(size) > static_cast<std::ptrdiff_t>(t_heap_limit))
+		{
+			++t_stats.num_failed_allocations;
+			throw std::bad_alloc{};
+		}
+	}
+
+	std::size_t get_held_size(void* ptr) noexcept
+	{
+#if defined(_MSC_VER)
+		return _msize(ptr);
+#elif defined(__GLIBC__)
+		return malloc_usable_size(ptr);
+#elif defined(__APPLE__)
+		return malloc_size(ptr);
+#else
+		return 0;
+#endif
+	}
+
+	std::size_t get_held_size_aligned(void* ptr, [[maybe_unused]] std::size_t align) noexcept
+	{
+#if defined(_MSC_VER)
+		return _aligned_msize(ptr, align, 0);
+#else
+		return get_held_size(ptr);
+#endif
+	}
+
+	void* allocate(std::size_t size)
+	{
+		const std::size_t requested = size;
+		check_heap_limit(size);
+		if (size == 0)
+		{
+			size = 1;
+		}
+		void* result = std::malloc(size);
+		if (result == nullptr)
+		{
+			throw std::bad_alloc{};
+		}
+		advent::record_allocation(requested, get_held_size(result));
+		return result;
+	}
+
+	void deallocate(void* ptr) noexcept
+	{
+		if (ptr == nullptr)
+		{
+			return;
+		}
+		advent::record_deallocation(get_held_size(ptr));
+		std::free(ptr);
+	}
+
+	void* allocate_aligned(std::size_t size, std::align_val_t alignment)
+	{
+		const std::size_t requested = size;
+		check_heap_limit(size);
+		const auto align = static_cast<std::size_t>(alignment);
+		if (size == 0)
+		{
+			size = align;
+		}
+#ifdef _MSC_VER
+		void* result = _aligned_malloc(size, align);
+#else
+		// aligned_alloc needs the size to be a multiple of the alignment.
+		size = (size + align - 1) / align * align;
+		void* result = std::aligned_alloc(align, size);
+#endif
+		if (result == nullptr)
+		{
+			throw std::bad_alloc{};
+		}
+		advent::record_allocation(requested, get_held_size_aligned(result, align));
+		return result;
+	}
+
+	void deallocate_aligned(void* ptr, std::align_val_t alignment) noexcept
+	{
+		if (ptr == nullptr)
+		{
+			return;
+		}
+		advent::record_deallocation(get_held_size_aligned(ptr, static_cast<std::size_t>(alignment)));
+#ifdef _MSC_VER
+		_aligned_free(ptr);
+#else
+		std::free(ptr);
+#endif
+	}
+}
+
+advent::allocation_stats advent::get_thread_allocation_stats() noexcept
+{
+	return t_stats;
+}
+
+void advent::reset_thread_peak_live_bytes() noexcept
+{
+	t_stats.peak_live_bytes = t_stats.live_bytes;
+}
+
+void advent::set_thread_heap_limit(std::size_t max_live_bytes) noexcept
+{
+	t_heap_limit = max_live_bytes;
+}
+
+void advent::record_allocation(std::size_t requested_bytes, std::size_t held_bytes) noexcept
+{
+	++t_stats.num_allocations;
+	t_stats.bytes_allocated += requested_bytes;
+	t_stats.live_bytes += static_cast<std::ptrdiff_t>(held_bytes);
+	t_stats.peak_live_bytes = std::max(t_stats.peak_live_bytes, t_stats.live_bytes);
+}
+
+void advent::record_deallocation(std::size_t held_bytes) noexcept
+{
+	t_stats.live_bytes -= static_cast<std::ptrdiff_t>(held_bytes);
+}
+
+void* operator new(std::size_t size)
+{
+	return allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+	return allocate_aligned(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t alignment) noexcept
+{
+	deallocate_aligned(ptr, alignment);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+	operator delete(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t alignment) noexcept
+{
+	operator delete(ptr, alignment);
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include <memory_resource>
+#include <memory>
+#include <optional>
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
+#include "../advent/advent_arena.h"
+
+namespace
+{
+	// Where the arena gets more memory once its buffer is full. Counts what it hands out so the
+	// buffer can be made big enough for the next run.
+	class overflow_resource : public std::pmr::memory_resource
+	{
+		std::size_t m_bytes_allocated = 0;
+
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override
+		{
+			void* result = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+			m_bytes_allocated += bytes;
+			return result;
+		}
+
+		void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override
+		{
+			std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+		{
+			return this == &other;
+		}
+	public:
+		std::size_t bytes_allocated() const noexcept { return m_bytes_allocated; }
+		void reset_count() noexcept { m_bytes_allocated = 0; }
+	};
+
+	class test_arena
+	{
+		static constexpr std::size_t INITIAL_SIZE = 64 * 1024;
+
+		// Runs that need more than this still work, but the extra is given back to the heap after each one
+		// rather than kept by the thread.
+		static constexpr std::size_t MAX_KEPT_SIZE = 64 * 1024 * 1024;
+
+		std::unique_ptr<std::byte[]> m_buffer;
+		std::size_t m_buffer_size = 0;
+		overflow_resource m_overflow;
+		std::optional<std::pmr::monotonic_buffer_resource> m_resource;
+
+		void set_buffer(std::unique_ptr<std::byte[]> new_buffer, std::size_t new_size)
+		{
+			m_resource.reset();
+			m_buffer = std::move(new_buffer);
+			m_buffer_size = new_size;
+			m_resource.emplace(m_buffer.get(), m_buffer_size, &m_overflow);
+		}
+	public:
+		test_arena() { set_buffer(std::make_unique<std::byte[]>(INITIAL_SIZE), INITIAL_SIZE); }
+
+		std::pmr::memory_resource* get() noexcept { return &*m_resource; }
+
+		void release()
+		{
+			m_resource->release();
+			const std::size_t needed = std::min(m_buffer_size + m_overflow.bytes_allocated(), MAX_KEPT_SIZE);
+			m_overflow.reset_count();
+			if (needed > m_buffer_size)
+			{
+				// Keeping the old buffer is fine if there is no room for a bigger one.
+				std::unique_ptr<std::byte[]> new_buffer{ new (std::nothrow) std::byte[needed] };
+				if (new_buffer != nullptr)
+				{
+					set_buffer(std::move(new_buffer), needed);
+				}
+			}
+		}
+	};
+
+	thread_local std::optional<test_arena> t_arena;
+	thread_local int t_scope_depth = 0;
+}
+
+std::pmr::memory_resource* advent::get_test_arena()
+{
+	if (!t_arena.has_value())
+	{
+		t_arena.emplace();
+	}
+	return t_arena->get();
+}
+
+advent::scoped_test_arena::scoped_test_arena() noexcept
+{
+	++t_scope_depth;
+}
+
+advent::scoped_test_arena::~scoped_test_arena()
+{
+	--t_scope_depth;
+	if (t_scope_depth == 0 && t_arena.has_value())
+	{
+		t_arena->release();
+	}
+}
\ No newline at end of file
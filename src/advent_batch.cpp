@@ -0,0 +1,181 @@
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <optional>
+#include <chrono>
+#include <mutex>
+#include <semaphore>
+#include <algorithm>
+#include <iomanip>
+
+#include "../advent/advent_batch.h"
+#include "../advent/advent_puzzle_solvers.h"
+
+#include "../utils/work_stealing_pool.h"
+
+namespace
+{
+	std::optional<std::vector<std::filesystem::path>> list_inputs(const std::filesystem::path& input_path)
+	{
+		std::error_code ec;
+		std::vector<std::filesystem::path> result;
+		if (std::filesystem::is_directory(input_path, ec))
+		{
+			for (const auto& entry : std::filesystem::directory_iterator{ input_path, ec })
+			{
+				if (entry.is_regular_file(ec))
+				{
+					result.push_back(entry.path());
+				}
+			}
+			if (ec) return std::nullopt;
+			std::ranges::sort(result);
+			return result;
+		}
+
+		std::ifstream manifest{ input_path };
+		if (!manifest) return std::nullopt;
+		std::string line;
+		while (std::getline(manifest, line))
+		{
+			if (!line.empty() && line.back() == '\r') line.pop_back();
+			if (line.empty() || line.front() == '#') continue;
+			const std::filesystem::path path{ line };
+			result.push_back(path.is_absolute() ? path : input_path.parent_path() / path);
+		}
+		return result;
+	}
+
+	std::optional<std::string> read_file(const std::filesystem::path& path)
+	{
+		std::ifstream file{ path, std::ios::binary };
+		if (!file) return std::nullopt;
+		std::ostringstream contents;
+		contents << file.rdbuf();
+		return std::move(contents).str();
+	}
+
+	std::string format_time(std::chrono::nanoseconds time)
+	{
+		std::ostringstream oss;
+		oss << std::fixed << std::setprecision(3) << std::chrono::duration<double, std::milli>{ time }.count() << "ms";
+		return oss.str();
+	}
+
+	// Holds each input's report until every input before it has been printed, so the output is in list order.
+	class ordered_printer
+	{
+		std::mutex m_lock;
+		std::vector<std::optional<std::string>> m_reports;
+		std::size_t m_next_to_print = 0;
+	public:
+		explicit ordered_printer(std::size_t num_reports) : m_reports(num_reports) {}
+
+		void add(std::size_t idx, std::string report)
+		{
+			std::scoped_lock lock{ m_lock };
+			m_reports[idx] = std::move(report);
+			while (m_next_to_print < m_reports.size() && m_reports[m_next_to_print].has_value())
+			{
+				std::cout << *m_reports[m_next_to_print];
+				m_reports[m_next_to_print].reset();
+				++m_next_to_print;
+			}
+			std::cout << std::flush;
+		}
+	};
+}
+
+bool advent::run_batch(const verify_options& options)
+{
+	const int day = options.day;
+	std::vector<const puzzle_solver*> solvers;
+	for (int part : { 1, 2 })
+	{
+		if (options.part != 0 && options.part != part) continue;
+		if (const puzzle_solver* solver = find_puzzle_solver(day, part))
+		{
+			solvers.push_back(solver);
+		}
+	}
+	if (solvers.empty())
+	{
+		std::cerr << "There is no solver for day " << day << " in this build.\n";
+		return false;
+	}
+
+	const std::filesystem::path input_path{ options.batch.input_path };
+	const std::optional<std::vector<std::filesystem::path>> inputs = list_inputs(input_path);
+	if (!inputs.has_value())
+	{
+		std::cerr << "Could not list inputs from '" << options.batch.input_path << "'\n";
+		return false;
+	}
+
+	ordered_printer printer{ inputs->size() };
+	std::mutex totals_lock;
+	std::size_t total_bytes = 0;
+	std::size_t num_failed = 0;
+
+	const auto wall_start_time = std::chrono::high_resolution_clock::now();
+	{
+		utils::work_stealing_pool pool{ options.num_threads };
+
+		// Limits how many inputs are held in memory at once: each one is read just before it is queued.
+		const std::size_t max_in_flight = options.batch.max_queued > 0 ? options.batch.max_queued : 2 * pool.size();
+		std::counting_semaphore<> slots{ static_cast<std::ptrdiff_t>(max_in_flight) };
+
+		for (std::size_t idx = 0; idx < inputs->size(); ++idx)
+		{
+			slots.acquire();
+			const std::filesystem::path& path = (*inputs)[idx];
+			std::optional<std::string> input = read_file(path);
+			if (!input.has_value())
+			{
+				printer.add(idx, path.string() + ": could not read the file\n");
+				std::scoped_lock lock{ totals_lock };
+				++num_failed;
+				slots.release();
+				continue;
+			}
+
+			pool.submit([idx, &path, input = std::move(*input), &solvers, &printer, &slots, &totals_lock, &total_bytes, &num_failed]()
+				{
+					std::ostringstream report;
+					report << path.string() << ':';
+					bool failed = false;
+					for (const puzzle_solver* solver : solvers)
+					{
+						const puzzle_answer answer = try_solve_puzzle(*solver, input);
+						report << " p" << solver->part << ' ' << (answer.failed ? "ERROR: " : "") << answer.result
+							<< " (" << format_time(answer.time_taken) << ");";
+						failed = failed || answer.failed;
+					}
+					std::string report_text = std::move(report).str();
+					report_text.back() = '\n';
+					{
+						std::scoped_lock lock{ totals_lock };
+						total_bytes += input.size();
+						num_failed += failed ? 1 : 0;
+					}
+					printer.add(idx, std::move(report_text));
+					slots.release();
+				});
+		}
+		pool.wait_idle();
+	}
+	const std::chrono::duration<double> wall_time = std::chrono::high_resolution_clock::now() - wall_start_time;
+
+	const double seconds = std::max(wall_time.count(), 1e-9);
+	std::cout << "BATCH (day " << day << "):\n"
+		"    INPUTS : " << inputs->size() << "\n"
+		"    FAILED : " << num_failed << "\n"
+		"    WALL   : " << format_time(std::chrono::duration_cast<std::chrono::nanoseconds>(wall_time)) << '\n'
+		<< std::fixed << std::setprecision(1)
+		<< "    RATE   : " << static_cast<double>(inputs->size()) / seconds << " inputs/s, "
+		<< static_cast<double>(total_bytes) / (1024.0 * 1024.0) / seconds << " MiB/s\n";
+	return num_failed == 0;
+}
\ No newline at end of file
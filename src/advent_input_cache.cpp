@@ -0,0 +1,137 @@
+#include <map>
+#include <mutex>
+#include <memory>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+
+#include "../advent/advent_input_cache.h"
+#include "../advent/advent_assert.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	// A file mapped into memory for as long as this object lives.
+	// If mapping fails (or the file is empty) the contents are read into m_fallback instead.
+	class mapped_file
+	{
+		std::string_view m_view;
+		std::string m_fallback;
+#ifdef _WIN32
+		HANDLE m_file = INVALID_HANDLE_VALUE;
+		HANDLE m_mapping = nullptr;
+#endif
+		void* m_address = nullptr;
+		std::size_t m_length = 0;
+
+		bool try_map(const std::string& filename)
+		{
+#ifdef _WIN32
+			m_file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+			if (m_file == INVALID_HANDLE_VALUE) return false;
+			LARGE_INTEGER size;
+			if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0) return false;
+			m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (m_mapping == nullptr) return false;
+			m_address = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+			if (m_address == nullptr) return false;
+			m_length = static_cast<std::size_t>(size.QuadPart);
+			m_view = std::string_view{ static_cast<const char*>(m_address), m_length };
+			return true;
+#else
+			const int fd = ::open(filename.c_str(), O_RDONLY);
+			if (fd < 0) return false;
+			struct stat file_info;
+			const bool got_size = ::fstat(fd, &file_info) == 0 && file_info.st_size > 0;
+			if (got_size)
+			{
+				m_length = static_cast<std::size_t>(file_info.st_size);
+				void* address = ::mmap(nullptr, m_length, PROT_READ, MAP_PRIVATE, fd, 0);
+				if (address != MAP_FAILED)
+				{
+					m_address = address;
+					::madvise(m_address, m_length, MADV_SEQUENTIAL);
+				}
+			}
+			::close(fd);
+			if (m_address == nullptr) return false;
+			m_view = std::string_view{ static_cast<const char*>(m_address), m_length };
+			return true;
+#endif
+		}
+
+		void read_fallback(const std::string& filename)
+		{
+			std::ifstream input{ filename, std::ios::binary };
+			std::ostringstream contents;
+			contents << input.rdbuf();
+			m_fallback = std::move(contents).str();
+			m_view = m_fallback;
+		}
+	public:
+		explicit mapped_file(const std::string& filename)
+		{
+			if (!try_map(filename))
+			{
+				read_fallback(filename);
+			}
+		}
+
+		~mapped_file()
+		{
+#ifdef _WIN32
+			if (m_address != nullptr)
+			{
+				UnmapViewOfFile(m_address);
+			}
+			if (m_mapping != nullptr) CloseHandle(m_mapping);
+			if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+#else
+			if (m_address != nullptr)
+			{
+				::munmap(m_address, m_length);
+			}
+#endif
+		}
+
+		mapped_file(const mapped_file&) = delete;
+		mapped_file& operator=(const mapped_file&) = delete;
+
+		std::string_view view() const noexcept { return m_view; }
+	};
+
+	struct input_cache
+	{
+		std::mutex lock;
+		std::map<std::string, std::unique_ptr<mapped_file>, std::less<>> files;
+	};
+
+	input_cache& get_cache()
+	{
+		static input_cache cache;
+		return cache;
+	}
+}
+
+std::string_view advent::get_input_view(const std::string& filename)
+{
+	input_cache& cache = get_cache();
+	std::scoped_lock lock{ cache.lock };
+	auto find_result = cache.files.find(filename);
+	if (find_result == end(cache.files))
+	{
+		AdventCheck(std::filesystem::exists(filename));
+		find_result = cache.files.emplace(filename, std::make_unique<mapped_file>(filename)).first;
+	}
+	return find_result->second->view();
+}
\ No newline at end of file
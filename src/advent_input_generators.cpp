@@ -0,0 +1,495 @@
+#include <array>
+#include <vector>
+#include <string_view>
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../advent/advent_input_generators.h"
+#include "../advent/advent_assert.h"
+
+// Each generator makes an input in the same format as the real puzzle input, sized from a typical real
+// input times the scale. Inputs only need to be valid, not to look like the real ones, but they are kept
+// close enough that a solver's work grows with them the same way.
+
+namespace
+{
+	// splitmix64. Used rather than <random> because the standard distributions give different
+	// numbers on different standard libraries.
+	class input_rng
+	{
+		std::uint64_t m_state;
+	public:
+		explicit input_rng(std::uint64_t seed) noexcept : m_state{ seed } {}
+
+		std::uint64_t next() noexcept
+		{
+			std::uint64_t z = (m_state += 0x9e3779b97f4a7c15);
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+			return z ^ (z >> 31);
+		}
+
+		// In [0, n).
+		std::size_t below(std::size_t n) noexcept
+		{
+			AdventCheck(n > 0);
+			return static_cast<std::size_t>(next() % n);
+		}
+
+		// In [low, high].
+		int between(int low, int high) noexcept
+		{
+			return low + static_cast<int>(below(static_cast<std::size_t>(high - low + 1)));
+		}
+
+		bool percent(int chance) noexcept
+		{
+			return below(100) < static_cast<std::size_t>(chance);
+		}
+
+		char pick(std::string_view options) noexcept
+		{
+			return options[below(options.size())];
+		}
+
+		template <typename T>
+		void shuffle(std::vector<T>& values) noexcept
+		{
+			for (std::size_t i = values.size(); i > 1; --i)
+			{
+				std::swap(values[i - 1], values[below(i)]);
+			}
+		}
+	};
+
+	// The side of a square grid with scale times as many cells as a base_side square.
+	int get_scaled_side(int base_side, std::size_t scale)
+	{
+		return static_cast<int>(std::lround(base_side * std::sqrt(static_cast<double>(scale))));
+	}
+
+	// Lines are separated, not terminated, by '\n' like the harness's test inputs.
+	class input_builder
+	{
+		std::string m_text;
+	public:
+		std::string& new_line()
+		{
+			if (!m_text.empty()) m_text.push_back('\n');
+			return m_text;
+		}
+		std::string take() noexcept { return std::move(m_text); }
+	};
+
+	template <typename CellFunc>
+	std::string make_grid(int width, int height, CellFunc get_cell)
+	{
+		input_builder result;
+		for (int y = 0; y < height; ++y)
+		{
+			std::string& text = result.new_line();
+			for (int x = 0; x < width; ++x)
+			{
+				text.push_back(get_cell(x, y));
+			}
+		}
+		return result.take();
+	}
+
+	// Calibration lines: letters, digits and spelled-out digits, with at least one real digit.
+	std::string generate_day1(std::size_t scale, input_rng& rng)
+	{
+		constexpr std::array<std::string_view, 9> WORDS{ "one", "two", "three", "four", "five", "six", "seven", "eight", "nine" };
+		input_builder result;
+		for (std::size_t line = 0; line < 1000 * scale; ++line)
+		{
+			std::string& text = result.new_line();
+			const std::size_t line_start = text.size();
+			bool has_digit = false;
+			const int length = rng.between(4, 40);
+			for (int i = 0; i < length; ++i)
+			{
+				if (rng.percent(10))
+				{
+					text.append(WORDS[rng.below(WORDS.size())]);
+				}
+				else if (rng.percent(15))
+				{
+					text.push_back(rng.pick("123456789"));
+					has_digit = true;
+				}
+				else
+				{
+					text.push_back(static_cast<char>('a' + rng.below(26)));
+				}
+			}
+			if (!has_digit)
+			{
+				text.insert(text.begin() + static_cast<std::ptrdiff_t>(line_start + rng.below(text.size() - line_start + 1)), rng.pick("123456789"));
+			}
+		}
+		return result.take();
+	}
+
+	// "Game N: 3 blue, 4 red; 1 red, 2 green"
+	std::string generate_day2(std::size_t scale, input_rng& rng)
+	{
+		constexpr std::array<std::string_view, 3> COLOURS{ "red", "green", "blue" };
+		input_builder result;
+		for (std::size_t game = 1; game <= 100 * scale; ++game)
+		{
+			std::string& text = result.new_line();
+			text.append("Game ").append(std::to_string(game)).append(":");
+			const int num_draws = rng.between(1, 6);
+			for (int draw = 0; draw < num_draws; ++draw)
+			{
+				if (draw > 0) text.push_back(';');
+				std::array<std::string_view, 3> colours = COLOURS;
+				const std::size_t num_colours = 1 + rng.below(3);
+				for (std::size_t c = 0; c < num_colours; ++c)
+				{
+					std::swap(colours[c], colours[c + rng.below(3 - c)]);
+					if (c > 0) text.push_back(',');
+					text.append(" ").append(std::to_string(rng.between(1, 20))).append(" ").append(colours[c]);
+				}
+			}
+		}
+		return result.take();
+	}
+
+	// "Card   1: 41 48 83 86 17 | 83 86  6 31 17  9 48 53"
+	// Few cards match much, so the number of copies in part 2 stays bounded however many cards there are.
+	std::string generate_day4(std::size_t scale, input_rng& rng)
+	{
+		constexpr std::size_t NUM_WINNING = 10;
+		constexpr std::size_t NUM_HAVE = 25;
+		auto append_number = [](std::string& text, int number)
+		{
+			if (number < 10) text.push_back(' ');
+			text.append(std::to_string(number)).push_back(' ');
+		};
+
+		std::vector<int> numbers(99);
+		input_builder result;
+		for (std::size_t card = 1; card <= 200 * scale; ++card)
+		{
+			std::iota(begin(numbers), end(numbers), 1);
+			rng.shuffle(numbers);
+			const std::size_t num_matches = rng.percent(60) ? 0 : 1 + rng.below(3);
+			std::vector<int> have(begin(numbers), begin(numbers) + num_matches);
+			have.insert(end(have), begin(numbers) + NUM_WINNING, begin(numbers) + NUM_WINNING + NUM_HAVE - num_matches);
+			rng.shuffle(have);
+
+			std::string& text = result.new_line();
+			const std::string card_str = std::to_string(card);
+			text.append("Card ").append(card_str.size() < 4 ? 4 - card_str.size() : 0, ' ').append(card_str).append(": ");
+			for (std::size_t i = 0; i < NUM_WINNING; ++i) append_number(text, numbers[i]);
+			text.append("| ");
+			for (int number : have) append_number(text, number);
+			text.pop_back();
+		}
+		return result.take();
+	}
+
+	// "32T3K 765"
+	std::string generate_day7(std::size_t scale, input_rng& rng)
+	{
+		input_builder result;
+		for (std::size_t hand = 0; hand < 1000 * scale; ++hand)
+		{
+			std::string& text = result.new_line();
+			for (int card = 0; card < 5; ++card)
+			{
+				text.push_back(rng.pick("23456789TJQKA"));
+			}
+			text.append(" ").append(std::to_string(rng.between(1, 1000)));
+		}
+		return result.take();
+	}
+
+	// Lines of 21 values of a polynomial, so the differences always reach zero.
+	std::string generate_day9(std::size_t scale, input_rng& rng)
+	{
+		input_builder result;
+		for (std::size_t line = 0; line < 200 * scale; ++line)
+		{
+			std::array<std::int64_t, 6> coefficients{};
+			const std::size_t degree = 1 + rng.below(coefficients.size() - 1);
+			for (std::size_t i = 0; i <= degree; ++i)
+			{
+				coefficients[i] = rng.between(-6, 6);
+			}
+
+			std::string& text = result.new_line();
+			for (std::int64_t x = 0; x < 21; ++x)
+			{
+				std::int64_t value = 0;
+				for (std::size_t i = coefficients.size(); i > 0; --i)
+				{
+					value = value * x + coefficients[i - 1];
+				}
+				if (x > 0) text.push_back(' ');
+				text.append(std::to_string(value));
+			}
+		}
+		return result.take();
+	}
+
+	// "???.### 1,1,3". The groups are read off a random row of springs before some are hidden.
+	std::string generate_day12(std::size_t scale, input_rng& rng)
+	{
+		input_builder result;
+		for (std::size_t line = 0; line < 1000 * scale; ++line)
+		{
+			std::string springs(static_cast<std::size_t>(rng.between(6, 20)), '.');
+			for (char& spring : springs)
+			{
+				if (rng.percent(45)) spring = '#';
+			}
+			springs[rng.below(springs.size())] = '#';
+
+			std::string groups;
+			std::size_t run = 0;
+			for (std::size_t i = 0; i <= springs.size(); ++i)
+			{
+				if (i < springs.size() && springs[i] == '#')
+				{
+					++run;
+					continue;
+				}
+				if (run > 0)
+				{
+					if (!groups.empty()) groups.push_back(',');
+					groups.append(std::to_string(run));
+				}
+				run = 0;
+			}
+
+			for (char& spring : springs)
+			{
+				if (rng.percent(40)) spring = '?';
+			}
+			result.new_line().append(springs).append(" ").append(groups);
+		}
+		return result.take();
+	}
+
+	std::string generate_day14(std::size_t scale, input_rng& rng)
+	{
+		const int side = get_scaled_side(100, scale);
+		return make_grid(side, side, [&rng](int, int)
+			{
+				const std::size_t roll = rng.below(100);
+				return roll < 20 ? 'O' : roll < 35 ? '#' : '.';
+			});
+	}
+
+	// One line of "label=N" and "label-" steps, separated by commas.
+	std::string generate_day15(std::size_t scale, input_rng& rng)
+	{
+		std::vector<std::string> labels(500);
+		for (std::string& label : labels)
+		{
+			const int length = rng.between(2, 6);
+			for (int i = 0; i < length; ++i)
+			{
+				label.push_back(static_cast<char>('a' + rng.below(26)));
+			}
+		}
+
+		std::string result;
+		for (std::size_t step = 0; step < 4000 * scale; ++step)
+		{
+			if (step > 0) result.push_back(',');
+			result.append(labels[rng.below(labels.size())]);
+			if (rng.percent(30))
+			{
+				result.push_back('-');
+			}
+			else
+			{
+				result.push_back('=');
+				result.push_back(rng.pick("123456789"));
+			}
+		}
+		return result;
+	}
+
+	std::string generate_day16(std::size_t scale, input_rng& rng)
+	{
+		const int side = get_scaled_side(110, scale);
+		return make_grid(side, side, [&rng](int, int)
+			{
+				return rng.percent(10) ? rng.pick("|-/\\") : '.';
+			});
+	}
+
+	std::string generate_day17(std::size_t scale, input_rng& rng)
+	{
+		const int side = get_scaled_side(141, scale);
+		return make_grid(side, side, [&rng](int, int)
+			{
+				return rng.pick("123456789");
+			});
+	}
+
+	// An x-monotone loop: a top edge walking left to right and a bottom edge walking back, kept apart so
+	// the trench never crosses itself. The colour codes describe the same loop so part 2 stays the same size.
+	std::string generate_day18(std::size_t scale, input_rng& rng)
+	{
+		struct column
+		{
+			int width;
+			int top;
+			int bottom;
+		};
+
+		std::vector<column> columns;
+		const std::size_t num_columns = 175 * scale;
+		columns.reserve(num_columns);
+		columns.push_back(column{ rng.between(1, 8), 10, -10 });
+		while (columns.size() < num_columns)
+		{
+			const column& previous = columns.back();
+			auto step = [&rng](int from)
+			{
+				const int change = rng.between(1, 6);
+				return rng.percent(50) ? from + change : from - change;
+			};
+			const column next{ rng.between(1, 8), step(previous.top), step(previous.bottom) };
+			if (next.bottom + 1 < next.top && next.bottom < previous.top && previous.bottom < next.top)
+			{
+				columns.push_back(next);
+			}
+		}
+
+		input_builder result;
+		auto add_instruction = [&result](char dir, int distance)
+		{
+			AdventCheck(distance > 0);
+			constexpr std::string_view DIRS = "RDLU";
+			std::array<char, 8> hex{};
+			const int hex_length = std::snprintf(hex.data(), hex.size(), "%05x", distance);
+			result.new_line().append(1, dir).append(" ").append(std::to_string(distance)).append(" (#")
+				.append(hex.data(), static_cast<std::size_t>(hex_length)).append(1, static_cast<char>('0' + DIRS.find(dir))).append(")");
+		};
+		auto add_vertical = [&add_instruction](int from, int to)
+		{
+			add_instruction(to > from ? 'U' : 'D', std::abs(to - from));
+		};
+
+		for (std::size_t i = 0; i < columns.size(); ++i)
+		{
+			add_instruction('R', columns[i].width);
+			if (i + 1 < columns.size()) add_vertical(columns[i].top, columns[i + 1].top);
+		}
+		add_vertical(columns.back().top, columns.back().bottom);
+		for (std::size_t i = columns.size(); i > 0; --i)
+		{
+			add_instruction('L', columns[i - 1].width);
+			if (i > 1) add_vertical(columns[i - 1].bottom, columns[i - 2].bottom);
+		}
+		add_vertical(columns.front().bottom, columns.front().top);
+		return result.take();
+	}
+
+	// Garden plots with a clear row and column through the start in the middle, like the real input.
+	std::string generate_day21(std::size_t scale, input_rng& rng)
+	{
+		int side = get_scaled_side(131, scale);
+		side += 1 - side % 2;
+		const int middle = side / 2;
+		return make_grid(side, side, [&rng, middle](int x, int y)
+			{
+				if (x == middle && y == middle) return 'S';
+				if (x == middle || y == middle) return '.';
+				return rng.percent(15) ? '#' : '.';
+			});
+	}
+
+	// "1,0,1~1,2,1" on a 10x10 footprint. Each brick starts above everything already in its columns,
+	// so none overlap, and most have a gap below them to fall through.
+	std::string generate_day22(std::size_t scale, input_rng& rng)
+	{
+		constexpr int SIDE = 10;
+		std::array<std::array<int, SIDE>, SIDE> heights{};
+		input_builder result;
+		for (std::size_t brick = 0; brick < 1200 * scale; ++brick)
+		{
+			std::array<int, 3> lower{ rng.between(0, SIDE - 1), rng.between(0, SIDE - 1), 0 };
+			std::array<int, 3> upper = lower;
+			const std::size_t axis = rng.below(3);
+			upper[axis] += rng.between(0, 4);
+			upper[0] = std::min(upper[0], SIDE - 1);
+			upper[1] = std::min(upper[1], SIDE - 1);
+
+			int floor = 0;
+			for (int x = lower[0]; x <= upper[0]; ++x)
+			{
+				for (int y = lower[1]; y <= upper[1]; ++y)
+				{
+					floor = std::max(floor, heights[x][y]);
+				}
+			}
+			const int height = upper[2] - lower[2];
+			lower[2] = floor + 1 + rng.between(0, 8);
+			upper[2] = lower[2] + height;
+			for (int x = lower[0]; x <= upper[0]; ++x)
+			{
+				for (int y = lower[1]; y <= upper[1]; ++y)
+				{
+					heights[x][y] = upper[2];
+				}
+			}
+
+			std::string& text = result.new_line();
+			for (std::size_t i = 0; i < 3; ++i)
+			{
+				if (i > 0) text.push_back(',');
+				text.append(std::to_string(lower[i]));
+			}
+			text.push_back('~');
+			for (std::size_t i = 0; i < 3; ++i)
+			{
+				if (i > 0) text.push_back(',');
+				text.append(std::to_string(upper[i]));
+			}
+		}
+		return result.take();
+	}
+
+	using generator_func = std::string(*)(std::size_t, input_rng&);
+
+	// Indexed by day - 1.
+	constexpr std::array<generator_func, 25> GENERATORS{
+		generate_day1, generate_day2, nullptr, generate_day4, nullptr,
+		nullptr, generate_day7, nullptr, generate_day9, nullptr,
+		nullptr, generate_day12, nullptr, generate_day14, generate_day15,
+		generate_day16, generate_day17, generate_day18, nullptr, nullptr,
+		generate_day21, generate_day22, nullptr, nullptr, nullptr
+	};
+
+	generator_func get_generator(int day) noexcept
+	{
+		if (day < 1 || day > static_cast<int>(GENERATORS.size())) return nullptr;
+		return GENERATORS[static_cast<std::size_t>(day - 1)];
+	}
+}
+
+bool advent::has_input_generator(int day) noexcept
+{
+	return get_generator(day) != nullptr;
+}
+
+std::optional<std::string> advent::generate_input(int day, std::size_t scale, std::uint64_t seed)
+{
+	const generator_func generator = get_generator(day);
+	if (generator == nullptr) return std::nullopt;
+	// Mix the day in so different days with the same seed are unrelated.
+	input_rng rng{ seed * 31 + static_cast<std::uint64_t>(day) };
+	return generator(std::max(scale, std::size_t{ 1 }), rng);
+}
\ No newline at end of file
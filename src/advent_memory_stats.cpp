@@ -0,0 +1,93 @@
+#include <string_view>
+#include <charconv>
+#include <fstream>
+#include <string>
+#include <algorithm>
+
+#include "../advent/advent_memory_stats.h"
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+#if defined(__linux__)
+	// Reads a line like "VmHWM:     1234 kB" from /proc/self/status.
+	std::optional<std::size_t> read_proc_status_kb(std::string_view key)
+	{
+		std::ifstream status{ "/proc/self/status" };
+		std::string line;
+		while (std::getline(status, line))
+		{
+			std::string_view view = line;
+			if (!view.starts_with(key) || view.size() <= key.size() || view[key.size()] != ':') continue;
+			view.remove_prefix(key.size() + 1);
+			view.remove_prefix(std::min(view.find_first_not_of(" \t"), view.size()));
+			std::size_t kb = 0;
+			const auto [ptr, ec] = std::from_chars(view.data(), view.data() + view.size(), kb);
+			if (ec != std::errc{}) return std::nullopt;
+			return kb * 1024;
+		}
+		return std::nullopt;
+	}
+#endif
+}
+
+bool advent::reset_peak_rss() noexcept
+{
+#if defined(__linux__)
+	// Writing 5 to clear_refs resets VmHWM (Linux 4.0 and later).
+	const int fd = ::open("/proc/self/clear_refs", O_WRONLY);
+	if (fd < 0) return false;
+	const bool success = ::write(fd, "5", 1) == 1;
+	::close(fd);
+	return success;
+#else
+	return false;
+#endif
+}
+
+std::optional<std::size_t> advent::get_current_rss_bytes()
+{
+#if defined(__linux__)
+	return read_proc_status_kb("VmRSS");
+#elif defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS counters{};
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return std::nullopt;
+	return counters.WorkingSetSize;
+#elif defined(__APPLE__)
+	mach_task_basic_info info{};
+	mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+	if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS) return std::nullopt;
+	return info.resident_size;
+#else
+	return std::nullopt;
+#endif
+}
+
+std::optional<std::size_t> advent::get_peak_rss_bytes()
+{
+#if defined(__linux__)
+	return read_proc_status_kb("VmHWM");
+#elif defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS counters{};
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return std::nullopt;
+	return counters.PeakWorkingSetSize;
+#elif defined(__APPLE__)
+	rusage usage{};
+	if (getrusage(RUSAGE_SELF, &usage) != 0) return std::nullopt;
+	return static_cast<std::size_t>(usage.ru_maxrss); // Bytes on macOS.
+#else
+	return std::nullopt;
+#endif
+}
\ No newline at end of file
@@ -9,11 +9,32 @@
 #include <iomanip>
 #include <cassert>
 #include <numeric>
+#include <streambuf>
+#include <cmath>
+#include <ranges>
+#include <filesystem>
 
 #include "../advent/advent_of_code.h"
 #include "../advent/advent_headers.h"
 #include "../advent/advent_setup.h"
 #include "../advent/advent_assert.h"
+#include "../advent/advent_allocation_stats.h"
+#include "../advent/advent_memory_stats.h"
+#include "../advent/advent_perf_counters.h"
+#include "../advent/advent_test_result.h"
+#include "../advent/advent_results_export.h"
+#include "../advent/advent_zones.h"
+#include "../advent/advent_input_generators.h"
+#include "../advent/advent_test_isolation.h"
+#include "../advent/advent_puzzle_solvers.h"
+#include "../advent/advent_server.h"
+#include "../advent/advent_batch.h"
+#include "../advent/advent_stdin_input.h"
+#include "../advent/advent_arena.h"
+#include "../advent/advent_utils.h"
+
+#include "../utils/work_stealing_pool.h"
+#include "../utils/view_istream.h"
 
 namespace
 {
@@ -35,25 +56,6 @@ std::string to_string(const std::optional<std::string>& os)
 	return os.value_or("");
 }
 
-// Result a test can give.
-enum class test_status : char
-{
-	pass,
-	fail,
-	unknown,
-	filtered
-};
-
-// Full results of a test.
-struct test_result
-{
-	std::string name;
-	std::string result;
-	std::string expected;
-	test_status status = test_status::unknown;
-	std::chrono::nanoseconds time_taken;
-};
-
 template <test_status status>
 bool check_result(const test_result& result)
 {
@@ -156,37 +158,386 @@ std::string to_human_readable(std::chrono::nanoseconds time)
 template <typename TestType>
 ResultType test_execute_wrapper(TestType test)
 {
-#ifdef NDEBUG
-	return test.execute();
-#else
+	// Running out of memory is reported in all builds, as it is what a memory limit does to a test.
 	try
 	{
+		const advent::scoped_test_arena arena;
+#ifdef NDEBUG
 		return test.execute();
+#else
+		try
+		{
+			return test.execute();
+		}
+		catch (const advent::test_failed& tf)
+		{
+			return std::string{ "ERROR: " } + std::string{ tf.what() };
+		}
+#endif
 	}
-	catch (const advent::test_failed& tf)
+	catch (const std::bad_alloc&)
 	{
-		return std::string{ "ERROR: " } + std::string{ tf.what() };
+		return std::string{ "ERROR: out of memory" };
 	}
-#endif
+}
+
+// What came out of a single execution of a test.
+struct test_run
+{
+	ResultType result;
+	std::chrono::nanoseconds time_taken;
+	allocation_summary allocations;
+	std::optional<perf_counter_values> counters;
+};
+
+allocation_summary get_allocation_summary(const advent::allocation_stats& start, const advent::allocation_stats& end)
+{
+	allocation_summary result;
+	result.num_allocations = end.num_allocations - start.num_allocations;
+	result.bytes_allocated = end.bytes_allocated - start.bytes_allocated;
+	result.peak_live_bytes = static_cast<std::size_t>(std::max(end.peak_live_bytes - start.live_bytes, std::ptrdiff_t{ 0 }));
+	return result;
 }
 
 template <typename TestType>
-std::pair<ResultType,std::chrono::nanoseconds> run_test_func(TestType test)
+test_run run_test_func(TestType test, bool read_counters)
 {
+	advent::perf_counters* const counters = read_counters ? &advent::get_thread_perf_counters() : nullptr;
+	advent::reset_thread_peak_live_bytes();
+	const auto start_allocs = advent::get_thread_allocation_stats();
+	if (counters != nullptr) counters->start();
 	const auto start_time = std::chrono::high_resolution_clock::now();
 	const ResultType res = test_execute_wrapper(std::move(test));
 	const auto end_time = std::chrono::high_resolution_clock::now();
-	return std::pair{res, end_time - start_time};
+	const std::optional<perf_counter_values> counter_values = counters != nullptr ? std::optional{ counters->stop() } : std::nullopt;
+	const auto end_allocs = advent::get_thread_allocation_stats();
+	return test_run{ res, end_time - start_time, get_allocation_summary(start_allocs, end_allocs), counter_values };
 }
 
 struct TestExecutor
 {
+	bool read_counters = false;
 	template <typename TestType>
-	std::pair<ResultType,std::chrono::nanoseconds> operator()(TestType test) { return run_test_func(std::move(test)); }
+	test_run operator()(TestType test) { return run_test_func(std::move(test), read_counters); }
 };
 
-test_result run_test(const verification_test& test, const std::vector<std::string_view>& filter)
+// Samples must not be empty.
+benchmark_stats make_benchmark_stats(std::vector<std::chrono::nanoseconds> samples, std::size_t total_allocations)
 {
+	AdventCheck(!samples.empty());
+	std::ranges::sort(samples);
+	const std::size_t num_samples = samples.size();
+
+	// Nearest-rank percentile.
+	auto percentile = [&samples, num_samples](std::size_t pc)
+	{
+		const std::size_t rank = (pc * num_samples + 99) / 100;
+		return samples[std::max(rank, std::size_t{ 1 }) - 1];
+	};
+
+	const double mean = std::transform_reduce(begin(samples), end(samples), 0.0, std::plus<double>{},
+		[](std::chrono::nanoseconds ns) { return static_cast<double>(ns.count()); }) / static_cast<double>(num_samples);
+	const double variance = num_samples < 2 ? 0.0 : std::transform_reduce(begin(samples), end(samples), 0.0, std::plus<double>{},
+		[mean](std::chrono::nanoseconds ns)
+		{
+			const double diff = static_cast<double>(ns.count()) - mean;
+			return diff * diff;
+		}) / static_cast<double>(num_samples - 1);
+
+	auto to_ns = [](double d) { return std::chrono::nanoseconds{ std::llround(d) }; };
+
+	benchmark_stats result;
+	result.num_runs = num_samples;
+	result.min = samples.front();
+	result.median = (num_samples % 2 == 1) ? samples[num_samples / 2] : (samples[num_samples / 2 - 1] + samples[num_samples / 2]) / 2;
+	result.p95 = percentile(95);
+	result.mean = to_ns(mean);
+	result.stddev = to_ns(std::sqrt(variance));
+	result.allocations_per_run = static_cast<double>(total_allocations) / static_cast<double>(num_samples);
+	return result;
+}
+
+// Does the warmup runs, then times the test until it runs out of runs or time (always at least once).
+benchmark_stats run_benchmark(const verification_test& test, const benchmark_options& options)
+{
+	for (std::size_t i = 0; i < options.warmup_runs; ++i)
+	{
+		std::visit(TestExecutor{}, test.test_func);
+	}
+
+	std::vector<std::chrono::nanoseconds> samples;
+	std::size_t total_allocations = 0;
+	std::chrono::nanoseconds time_spent{ 0 };
+	auto keep_going = [&]()
+	{
+		if (samples.empty()) return true;
+		if (options.max_runs > 0 && samples.size() >= options.max_runs) return false;
+		if (options.time_budget.count() > 0 && time_spent >= options.time_budget) return false;
+		return true;
+	};
+
+	while (keep_going())
+	{
+		const test_run run = std::visit(TestExecutor{}, test.test_func);
+		samples.push_back(run.time_taken);
+		total_allocations += run.allocations.num_allocations;
+		time_spent += run.time_taken;
+	}
+	return make_benchmark_stats(std::move(samples), total_allocations);
+}
+
+// Counts of ten thousand or more are shortened to "12.3k", "456.7M" and so on.
+std::string counter_to_string(const std::optional<std::uint64_t>& count)
+{
+	if (!count.has_value()) return "n/a";
+	constexpr std::array<std::pair<double, char>, 3> scales{ std::pair{ 1e9, 'G' }, std::pair{ 1e6, 'M' }, std::pair{ 1e3, 'k' } };
+	const double value = static_cast<double>(*count);
+	for (const auto& [scale, suffix] : scales)
+	{
+		if (value >= 10 * scale)
+		{
+			std::ostringstream oss;
+			oss << std::fixed << std::setprecision(1) << value / scale << suffix;
+			return oss.str();
+		}
+	}
+	return std::to_string(*count);
+}
+
+std::string to_string(const perf_counter_values& counters)
+{
+	std::ostringstream oss;
+	oss << "cycles " << counter_to_string(counters.cycles)
+		<< ", instructions " << counter_to_string(counters.instructions);
+	if (counters.cycles.has_value() && counters.instructions.has_value() && *counters.cycles > 0)
+	{
+		oss << " (IPC " << std::fixed << std::setprecision(2) << static_cast<double>(*counters.instructions) / static_cast<double>(*counters.cycles) << ')';
+	}
+	oss << ", L1D misses " << counter_to_string(counters.l1d_misses)
+		<< ", LLC misses " << counter_to_string(counters.llc_misses)
+		<< ", branch misses " << counter_to_string(counters.branch_misses);
+	return oss.str();
+}
+
+// Sizes of ten KiB or more are shortened to "12.3 KiB", "456.7 MiB" and so on.
+std::string bytes_to_string(std::size_t bytes)
+{
+	constexpr std::array<std::pair<double, std::string_view>, 3> scales{ std::pair{ 1024.0 * 1024.0 * 1024.0, "GiB" }, std::pair{ 1024.0 * 1024.0, "MiB" }, std::pair{ 1024.0, "KiB" } };
+	const double value = static_cast<double>(bytes);
+	for (const auto& [scale, suffix] : scales)
+	{
+		if (value >= 10 * scale)
+		{
+			std::ostringstream oss;
+			oss << std::fixed << std::setprecision(1) << value / scale << ' ' << suffix;
+			return oss.str();
+		}
+	}
+	return std::to_string(bytes) + " B";
+}
+
+std::string to_string(const allocation_summary& allocations)
+{
+	std::ostringstream oss;
+	oss << counter_to_string(allocations.num_allocations) << " allocations, "
+		<< bytes_to_string(allocations.bytes_allocated) << " allocated, peak "
+		<< bytes_to_string(allocations.peak_live_bytes) << " live";
+	return oss.str();
+}
+
+// Total time in each zone name, in the order they were first entered. A zone nested inside another
+// of the same name is not counted again, so recursive zones are not double-counted.
+std::string to_string(const advent::zone_trace& trace)
+{
+	struct zone_total
+	{
+		std::string_view name;
+		std::size_t count = 0;
+		std::chrono::nanoseconds total{ 0 };
+	};
+	std::vector<zone_total> totals;
+	std::vector<std::string_view> open_zones;
+	for (const advent::zone_record& record : trace.records)
+	{
+		open_zones.resize(record.depth);
+		const std::string_view name = record.name;
+		const bool nested_in_same_name = std::ranges::find(open_zones, name) != end(open_zones);
+		open_zones.push_back(name);
+		if (nested_in_same_name) continue;
+
+		auto find_result = std::ranges::find(totals, name, &zone_total::name);
+		if (find_result == end(totals))
+		{
+			totals.push_back(zone_total{ name });
+			find_result = end(totals) - 1;
+		}
+		++find_result->count;
+		find_result->total += record.duration;
+	}
+
+	std::ostringstream oss;
+	oss << "zones:";
+	// The test's own zone, which is always first, is just the time taken.
+	for (const zone_total& total : totals | std::views::drop(1))
+	{
+		oss << ' ' << total.name << ' ' << to_human_readable(total.total);
+		if (total.count > 1)
+		{
+			oss << " (x" << total.count << ')';
+		}
+		oss << ';';
+	}
+	std::string result = std::move(oss).str();
+	if (result.ends_with(';'))
+	{
+		result.pop_back();
+	}
+	else
+	{
+		result += " none";
+	}
+	return result;
+}
+
+std::string to_string(const memory_usage& memory)
+{
+	auto optional_bytes_to_string = [](const std::optional<std::size_t>& bytes)
+	{
+		return bytes.has_value() ? bytes_to_string(*bytes) : std::string{ "n/a" };
+	};
+	std::ostringstream oss;
+	oss << "peak RSS " << optional_bytes_to_string(memory.peak_rss_bytes)
+		<< ", +" << optional_bytes_to_string(memory.rss_increase_bytes) << " during the test";
+	if (memory.exceeded_limit)
+	{
+		oss << ", OVER THE MEMORY LIMIT";
+	}
+	return oss.str();
+}
+
+std::string to_string(const benchmark_stats& stats)
+{
+	std::ostringstream oss;
+	oss << stats.num_runs << " runs: min " << to_human_readable(stats.min)
+		<< ", median " << to_human_readable(stats.median)
+		<< ", p95 " << to_human_readable(stats.p95)
+		<< ", stddev " << to_human_readable(stats.stddev)
+		<< ", " << std::fixed << std::setprecision(1) << stats.allocations_per_run << " allocations/run";
+	return oss.str();
+}
+
+test_result run_test_in_process(const verification_test& test, const verify_options& options)
+{
+	advent::zone_recorder zones;
+	const std::size_t memory_limit = options.memory_limit_mb * 1024 * 1024;
+	std::optional<std::size_t> rss_at_start;
+	if (options.measuring_memory())
+	{
+		advent::reset_peak_rss();
+		rss_at_start = advent::get_current_rss_bytes();
+	}
+	const advent::allocation_stats allocs_at_start = advent::get_thread_allocation_stats();
+	const test_run first_run = [&]()
+	{
+		const advent::scoped_zone_recording recording{ options.recording_zones() ? &zones : nullptr };
+		if (memory_limit > 0)
+		{
+			const auto live_bytes = static_cast<std::size_t>(std::max(allocs_at_start.live_bytes, std::ptrdiff_t{ 0 }));
+			advent::set_thread_heap_limit(live_bytes + memory_limit);
+		}
+		AdventZone(test.name.data());
+		test_run result = std::visit(TestExecutor{ options.perf_counters }, test.test_func);
+		advent::set_thread_heap_limit(0);
+		return result;
+	}();
+
+	std::optional<memory_usage> memory;
+	if (options.measuring_memory())
+	{
+		memory_usage usage;
+		usage.peak_rss_bytes = advent::get_peak_rss_bytes();
+		if (usage.peak_rss_bytes.has_value() && rss_at_start.has_value())
+		{
+			usage.rss_increase_bytes = *usage.peak_rss_bytes - std::min(*usage.peak_rss_bytes, *rss_at_start);
+		}
+		const bool hit_heap_limit = advent::get_thread_allocation_stats().num_failed_allocations > allocs_at_start.num_failed_allocations;
+		const bool over_rss_limit = memory_limit > 0 && usage.rss_increase_bytes.value_or(0) > memory_limit;
+		usage.exceeded_limit = hit_heap_limit || over_rss_limit;
+		memory = usage;
+	}
+	const auto string_result = to_string(first_run.result);
+	const std::optional<std::string> expected_result = test.expected_result.get();
+	std::cout << "\nFinished " << test.name << ": took " << to_human_readable(first_run.time_taken);
+	if (options.allocation_stats)
+	{
+		std::cout << " (" << to_string(first_run.allocations) << ')';
+	}
+	if (memory.has_value())
+	{
+		std::cout << " (" << to_string(*memory) << ')';
+	}
+	std::cout << " and got " << string_result << '\n';
+
+	std::optional<benchmark_stats> benchmark;
+	if (options.benchmark.enabled())
+	{
+		benchmark = run_benchmark(test, options.benchmark);
+		std::cout << "Benchmarked " << test.name << ": " << to_string(*benchmark) << '\n';
+	}
+	const std::chrono::nanoseconds time_taken = benchmark.has_value() ? benchmark->median : first_run.time_taken;
+
+	auto get_result = [&](test_status status)
+	{
+		std::optional<perf_counter_values> counters;
+		if (first_run.counters.has_value() && first_run.counters->any())
+		{
+			counters = first_run.counters;
+		}
+		std::optional<allocation_summary> allocations;
+		if (options.allocation_stats)
+		{
+			allocations = first_run.allocations;
+		}
+		std::optional<advent::zone_trace> zone_trace;
+		if (options.recording_zones())
+		{
+			zone_trace = zones.take_trace();
+		}
+		return test_result{ std::string{ test.name },string_result,to_string(expected_result),status,time_taken,benchmark,counters,allocations,std::move(zone_trace),memory };
+	};
+
+	if (memory.has_value() && memory->exceeded_limit)
+	{
+		return get_result(test_status::fail);
+	}
+	if(!expected_result.has_value())
+	{
+		return get_result(test_status::unknown);
+	}
+	else
+	{
+		return get_result(string_result == *expected_result ? test_status::pass : test_status::fail);
+	}
+}
+
+// Maps the input files of the test's day into the input cache, so a forked child finds them there
+// and does not have to read them while another thread of the parent might have held a lock.
+void preload_inputs(const verification_test& test)
+{
+	if (test.day <= 0) return;
+	std::error_code ec;
+	for (const auto& entry : std::filesystem::directory_iterator{ "advent" + std::to_string(test.day), ec })
+	{
+		if (entry.is_regular_file(ec) && entry.path().extension() == ".txt")
+		{
+			advent::get_input_view(entry.path().generic_string());
+		}
+	}
+}
+
+test_result run_test(const verification_test& test, const verify_options& options)
+{
+	const std::vector<std::string_view>& filter = options.filters;
 	if(!filter.empty())
 	{
 		auto filter_pred = [name = std::string_view{ test.name }](std::string_view filter_item)
@@ -197,60 +548,513 @@ test_result run_test(const verification_test& test, const std::vector<std::strin
 		if(!matches_filter)
 		{
 			return test_result{
-				test.name,
+				std::string{ test.name },
 				"",
-				to_string(test.expected_result),
+				to_string(test.expected_result.get()),
 				test_status::filtered
 			};
 		}
 	}
 	std::cout << "Running test " << test.name << "...";
-	const auto [res,time_taken] = std::visit(TestExecutor{}, test.test_func);
-	const auto string_result = to_string(res);
-	std::cout << "\nFinished " << test.name << ": took " << to_human_readable(time_taken) <<  " and got " << string_result << '\n';
-	auto get_result = [&](test_status status)
+	if (options.isolating() && advent::can_isolate_tests())
 	{
-		return test_result{ test.name,string_result,to_string(test.expected_result),status,time_taken };
+		preload_inputs(test);
+		test_result result = advent::run_isolated(test.name, test.expected_result.get(), options.timeout,
+			[&test, &options]() { return run_test_in_process(test, options); });
+		if (result.status == test_status::timeout || result.status == test_status::crash)
+		{
+			std::cout << "\nFinished " << test.name << ": " << result.result << '\n';
+		}
+		return result;
+	}
+	return run_test_in_process(test, options);
+}
+
+namespace
+{
+	constexpr auto NUM_TESTS = std::size(tests);
+	using test_results = std::array<test_result, NUM_TESTS>;
+
+	// Passes everything written to it on to a buffer chosen by the writing thread, or to the
+	// fallback buffer if that thread has not chosen one. Installing this on std::cout lets tests
+	// running in parallel each collect their own output. StreamTag keeps the thread's choice for
+	// one stream (e.g. std::cout) separate from its choice for another (std::cerr).
+	template <typename StreamTag>
+	class per_thread_streambuf : public std::streambuf
+	{
+		std::streambuf& m_fallback;
+		static inline thread_local std::streambuf* t_target = nullptr;
+		std::streambuf& get_target() const noexcept { return t_target != nullptr ? *t_target : m_fallback; }
+	protected:
+		int_type overflow(int_type ch) override
+		{
+			if (traits_type::eq_int_type(ch, traits_type::eof()))
+			{
+				return traits_type::not_eof(ch);
+			}
+			return get_target().sputc(traits_type::to_char_type(ch));
+		}
+		std::streamsize xsputn(const char* s, std::streamsize count) override
+		{
+			return get_target().sputn(s, count);
+		}
+		int sync() override
+		{
+			return get_target().pubsync();
+		}
+	public:
+		explicit per_thread_streambuf(std::streambuf& fallback) : m_fallback{ fallback } {}
+
+		// Sends output from this thread to target until destroyed.
+		class scoped_capture
+		{
+			std::streambuf* m_previous;
+		public:
+			explicit scoped_capture(std::streambuf& target) noexcept : m_previous{ t_target } { t_target = &target; }
+			~scoped_capture() noexcept { t_target = m_previous; }
+			scoped_capture(const scoped_capture&) = delete;
+			scoped_capture& operator=(const scoped_capture&) = delete;
+		};
 	};
 
-	if(!test.expected_result.has_value())
+	void run_tests_serial(const verify_options& options, test_results& results)
 	{
-		return get_result(test_status::unknown);
+		std::ranges::transform(tests, begin(results),
+			[&options](const verification_test& test)
+			{
+				return run_test(test, options);
+			});
 	}
-	else
+
+	struct cout_tag {};
+	struct cerr_tag {};
+
+	// Runs the tests on a thread pool. Each test's output (to std::cout and std::cerr) is held back
+	// and printed in the original order once everything has finished.
+	// Only the buffers are per thread: the streams' format state (flags, precision, fill) is still
+	// shared between the workers, so tests must not change it.
+	void run_tests_parallel(const verify_options& options, test_results& results)
 	{
-		return get_result(string_result == *test.expected_result ? test_status::pass : test_status::fail);
+		std::array<std::string, NUM_TESTS> outputs;
+		std::array<std::string, NUM_TESTS> errors;
+		per_thread_streambuf<cout_tag> out_router{ *std::cout.rdbuf() };
+		per_thread_streambuf<cerr_tag> err_router{ *std::cerr.rdbuf() };
+		std::streambuf* const original_out_buf = std::cout.rdbuf(&out_router);
+		std::streambuf* const original_err_buf = std::cerr.rdbuf(&err_router);
+		{
+			utils::work_stealing_pool pool{ options.num_threads };
+			for (std::size_t idx = 0; idx < NUM_TESTS; ++idx)
+			{
+				pool.submit([idx, &options, &results, &outputs, &errors]()
+					{
+						std::ostringstream captured_out;
+						std::ostringstream captured_err;
+						{
+							const per_thread_streambuf<cout_tag>::scoped_capture out_capture{ *captured_out.rdbuf() };
+							const per_thread_streambuf<cerr_tag>::scoped_capture err_capture{ *captured_err.rdbuf() };
+							results[idx] = run_test(tests[idx], options);
+						}
+						outputs[idx] = std::move(captured_out).str();
+						errors[idx] = std::move(captured_err).str();
+					});
+			}
+			pool.wait_idle();
+		}
+		std::cout.rdbuf(original_out_buf);
+		std::cerr.rdbuf(original_err_buf);
+		for (std::size_t idx = 0; idx < NUM_TESTS; ++idx)
+		{
+			std::cerr << errors[idx];
+			std::cout << outputs[idx];
+		}
+	}
+
+	// Writes the results file and checks against the baseline, if either was asked for.
+	// Returns false if anything went wrong or any test has slowed down too much.
+	bool export_results(const export_options& options, std::span<const test_result> results)
+	{
+		bool success = true;
+		if (!options.output_path.empty())
+		{
+			success = advent::write_results(options.output_path, results) && success;
+		}
+
+		if (!options.trace_path.empty())
+		{
+			success = advent::write_chrome_trace(options.trace_path, results) && success;
+		}
+
+		if (!options.baseline_path.empty())
+		{
+			const auto baseline = advent::read_results(options.baseline_path);
+			if (!baseline.has_value())
+			{
+				return false;
+			}
+			const auto regressions = advent::find_regressions(results, *baseline, options);
+			for (const advent::timing_regression& regression : regressions)
+			{
+				const double percent_change = 100.0 * static_cast<double>((regression.current_time - regression.baseline_time).count()) / static_cast<double>(std::max(regression.baseline_time.count(), std::chrono::nanoseconds::rep{ 1 }));
+				std::ostringstream oss;
+				oss << regression.name << ": " << to_human_readable(regression.baseline_time) << " -> " << to_human_readable(regression.current_time)
+					<< " (+" << std::fixed << std::setprecision(1) << percent_change << "%) - SLOWER\n";
+				std::cout << oss.str();
+			}
+			const auto status_changes = advent::find_status_changes(results, *baseline);
+			for (const advent::status_change& change : status_changes)
+			{
+				std::cout << change.name << ": " << change.baseline_status << " -> " << change.current_status << " - CHANGED\n";
+			}
+			std::cout << "    SLOWER : " << regressions.size() << " (compared to " << options.baseline_path << ")\n";
+			std::cout << "    CHANGED: " << status_changes.size() << '\n';
+			success = success && regressions.empty();
+		}
+		return success;
 	}
 }
 
-bool verify_all(const std::vector<std::string_view>& filter)
+namespace
 {
-	constexpr auto NUM_TESTS = std::size(tests);
-	std::array<test_result, NUM_TESTS> results;
-	std::ranges::transform(tests, begin(results),
-		[&filter](const verification_test& test)
+	// Solvers that take the whole puzzle input, for days that have an input generator. Named like the day's
+	// advent_ tests, so the same filters pick them.
+	struct sweep_target
+	{
+		std::string_view name;
+		int day;
+		ResultType(*solve)(std::istream&);
+	};
+
+	constexpr auto get_all_sweep_targets()
+	{
+		return std::to_array<sweep_target>({
+			{ "advent_one_p1", 1, testcase_one_p1 }, { "advent_one_p2", 1, testcase_one_p2 },
+			{ "advent_two_p1", 2, testcase_two_p1 }, { "advent_two_p2", 2, testcase_two_p2 },
+			{ "advent_four_p1", 4, testcase_four_p1 }, { "advent_four_p2", 4, testcase_four_p2 },
+			{ "advent_seven_p1", 7, testcase_seven_p1_b }, { "advent_seven_p2", 7, testcase_seven_p2_b },
+			{ "advent_nine_p1", 9, testcase_nine_p1 }, { "advent_nine_p2", 9, testcase_nine_p2 },
+			{ "advent_twelve_p1", 12, testcase_twelve_p1 }, { "advent_twelve_p2", 12, testcase_twelve_p2 },
+			{ "advent_fourteen_p1", 14, testcase_fourteen_p1 }, { "advent_fourteen_p2", 14, testcase_fourteen_p2 },
+			{ "advent_fifteen_p1", 15, testcase_fifteen_p1 }, { "advent_fifteen_p2", 15, testcase_fifteen_p2 },
+			{ "advent_sixteen_p1", 16, testcase_sixteen_p1 }, { "advent_sixteen_p2", 16, testcase_sixteen_p2 },
+			{ "advent_seventeen_p1", 17, testcase_seventeen_p1 }, { "advent_seventeen_p2", 17, testcase_seventeen_p2 },
+			{ "advent_eighteen_p1", 18, testcase_eighteen_p1 },
+			{ "advent_twentyone_p1", 21, testcase_twentyone_p1 },
+			{ "advent_twentytwo_p1", 22, testcase_twentytwo_p1 }, { "advent_twentytwo_p2", 22, testcase_twentytwo_p2 }
+		});
+	}
+
+	constexpr auto is_sweep_target_selected = [](const sweep_target& target) { return is_day_selected(target.day); };
+	constexpr auto SWEEP_TARGETS = select_if<std::ranges::count_if(get_all_sweep_targets(), is_sweep_target_selected)>(get_all_sweep_targets(), is_sweep_target_selected);
+
+	// 1, 2, 5, 10, 20, 50... up to max_scale, which is always included.
+	std::vector<std::size_t> get_sweep_scales(std::size_t max_scale)
+	{
+		std::vector<std::size_t> result;
+		for (std::size_t decade = 1; decade <= max_scale; decade *= 10)
+		{
+			for (std::size_t step : { 1, 2, 5 })
+			{
+				if (decade * step < max_scale) result.push_back(decade * step);
+			}
+		}
+		result.push_back(max_scale);
+		return result;
+	}
+
+	// The slope of the least-squares line through (log size, log time): time grows as size^slope.
+	double get_growth_exponent(std::span<const std::pair<std::size_t, std::chrono::nanoseconds>> samples)
+	{
+		AdventCheck(samples.size() >= 2);
+		double sum_x = 0.0, sum_y = 0.0, sum_xx = 0.0, sum_xy = 0.0;
+		for (const auto& [size, time] : samples)
+		{
+			const double x = std::log(static_cast<double>(size));
+			const double y = std::log(static_cast<double>(std::max(time.count(), std::chrono::nanoseconds::rep{ 1 })));
+			sum_x += x;
+			sum_y += y;
+			sum_xx += x * x;
+			sum_xy += x * y;
+		}
+		const double n = static_cast<double>(samples.size());
+		const double denominator = n * sum_xx - sum_x * sum_x;
+		return denominator != 0.0 ? (n * sum_xy - sum_x * sum_y) / denominator : 0.0;
+	}
+
+	// Returns false if the solver failed at any scale.
+	bool run_sweep(const sweep_target& target, const verify_options& options)
+	{
+		std::cout << "Sweep " << target.name << " (seed " << options.sweep.seed << "):\n";
+		const std::size_t num_runs = std::max(options.benchmark.max_runs, std::size_t{ 1 });
+		std::vector<std::pair<std::size_t, std::chrono::nanoseconds>> samples;
+		for (std::size_t scale : get_sweep_scales(options.sweep.max_scale))
+		{
+			const std::optional<std::string> input = advent::generate_input(target.day, scale, options.sweep.seed);
+			AdventCheck(input.has_value());
+			std::chrono::nanoseconds fastest = std::chrono::nanoseconds::max();
+			std::string result;
+			for (std::size_t run = 0; run < num_runs; ++run)
+			{
+				utils::view_istream input_stream{ *input };
+				const auto start_time = std::chrono::high_resolution_clock::now();
+				try
+				{
+					const advent::scoped_test_arena arena;
+					result = to_string(target.solve(input_stream));
+				}
+				catch (const advent::test_failed& tf)
+				{
+					std::cout << "    x" << scale << ": ERROR: " << tf.what() << '\n';
+					return false;
+				}
+				fastest = std::min<std::chrono::nanoseconds>(fastest, std::chrono::high_resolution_clock::now() - start_time);
+			}
+			std::cout << "    x" << scale << ": " << bytes_to_string(input->size()) << " in " << to_human_readable(fastest) << " (got " << result << ")\n" << std::flush;
+			samples.emplace_back(input->size(), fastest);
+		}
+		if (samples.size() >= 2)
+		{
+			std::cout << "    Time grows as n^" << std::fixed << std::setprecision(2) << get_growth_exponent(samples) << std::defaultfloat << " in input size\n";
+		}
+		return true;
+	}
+
+	bool run_scale_sweep(const verify_options& options)
+	{
+		bool success = true;
+		bool any_run = false;
+		for (const sweep_target& target : SWEEP_TARGETS)
+		{
+			const bool matches_filter = options.filters.empty() || std::ranges::any_of(options.filters,
+				[&target](std::string_view filter) { return target.name.find(filter) != std::string_view::npos; });
+			if (!matches_filter) continue;
+			AdventCheck(advent::has_input_generator(target.day));
+			success = run_sweep(target, options) && success;
+			any_run = true;
+		}
+		if (!any_run)
+		{
+			std::cout << "No solvers with input generators match the filters.\n";
+		}
+		return success && any_run;
+	}
+}
+
+namespace
+{
+	// The tests that run a day's own puzzle, like advent_one_p1.
+	constexpr auto is_puzzle_solver = [](const verification_test& test)
+	{
+		return test.name.starts_with("advent_") && test.part != 0 && std::holds_alternative<TestExecutable>(test.test_func);
+	};
+
+	// Days whose solutions read their input a line at a time, so can work on a stream as it arrives.
+	constexpr auto get_all_streaming_solvers()
+	{
+		struct streaming_solver
+		{
+			int day;
+			int part;
+			ResultType(*solve)(std::istream&);
+		};
+		return std::to_array<streaming_solver>({
+			{ 1, 1, testcase_one_p1 }, { 1, 2, testcase_one_p2 },
+			{ 2, 1, testcase_two_p1 }, { 2, 2, testcase_two_p2 },
+			{ 4, 1, testcase_four_p1 }, { 4, 2, testcase_four_p2 },
+			{ 7, 1, testcase_seven_p1_b }, { 7, 2, testcase_seven_p2_b },
+			{ 9, 1, testcase_nine_p1 }, { 9, 2, testcase_nine_p2 },
+			{ 12, 1, testcase_twelve_p1 }, { 12, 2, testcase_twelve_p2 },
+			{ 15, 1, testcase_fifteen_p1 }, { 15, 2, testcase_fifteen_p2 },
+			{ 19, 1, testcase_nineteen_p1 }, { 19, 2, testcase_nineteen_p2 }
+		});
+	}
+
+	constexpr auto PUZZLE_SOLVERS = []()
+	{
+		constexpr std::size_t NUM_SOLVERS = std::ranges::count_if(tests, is_puzzle_solver);
+		std::array<advent::puzzle_solver, NUM_SOLVERS> result{};
+		std::ranges::transform(select_if<NUM_SOLVERS>(tests, is_puzzle_solver), begin(result), [](const verification_test& test)
+			{
+				return advent::puzzle_solver{ test.day, test.part, std::get<TestExecutable>(test.test_func).func };
+			});
+		// Only days that are built in get their streaming solver, so the others are never referenced.
+		for (const auto& streaming : get_all_streaming_solvers())
+		{
+			for (advent::puzzle_solver& solver : result)
+			{
+				if (solver.day == streaming.day && solver.part == streaming.part)
+				{
+					solver.solve_stream = streaming.solve;
+				}
+			}
+		}
+		return result;
+	}();
+
+	template <typename SolveFunc>
+	advent::puzzle_answer try_solve(SolveFunc solve)
+	{
+		advent::puzzle_answer answer;
+		const auto start_time = std::chrono::high_resolution_clock::now();
+		try
+		{
+			const advent::scoped_test_arena arena;
+			answer.result = to_string(solve());
+		}
+		catch (const advent::test_failed& tf)
+		{
+			answer.result = tf.what();
+			answer.failed = true;
+		}
+		catch (const std::bad_alloc&)
+		{
+			answer.result = "out of memory";
+			answer.failed = true;
+		}
+		catch (const std::exception& e)
+		{
+			answer.result = e.what();
+			answer.failed = true;
+		}
+		answer.time_taken = std::chrono::high_resolution_clock::now() - start_time;
+		return answer;
+	}
+}
+
+std::span<const advent::puzzle_solver> advent::get_puzzle_solvers() noexcept
+{
+	return PUZZLE_SOLVERS;
+}
+
+const advent::puzzle_solver* advent::find_puzzle_solver(int day, int part) noexcept
+{
+	const auto find_result = std::ranges::find_if(PUZZLE_SOLVERS, [day, part](const puzzle_solver& solver)
 		{
-			return run_test(test, filter);
+			return solver.day == day && solver.part == part;
 		});
+	return find_result != end(PUZZLE_SOLVERS) ? &*find_result : nullptr;
+}
+
+ResultType advent::solve_puzzle(const puzzle_solver& solver, std::string_view input)
+{
+	const scoped_puzzle_input puzzle_input{ input };
+	return solver.solve();
+}
+
+advent::puzzle_answer advent::try_solve_puzzle(const puzzle_solver& solver, std::string_view input)
+{
+	return try_solve([&solver, input]() { return solve_puzzle(solver, input); });
+}
+
+advent::puzzle_answer advent::try_solve_puzzle(const puzzle_solver& solver, std::istream& input)
+{
+	if (solver.solve_stream != nullptr)
+	{
+		return try_solve([&solver, &input]() { return solver.solve_stream(input); });
+	}
+	std::ostringstream contents;
+	contents << input.rdbuf();
+	return try_solve_puzzle(solver, std::move(contents).str());
+}
+
+bool verify_all(const std::vector<std::string_view>& filter)
+{
+	verify_options options;
+	options.filters = filter;
+	return verify_all(options);
+}
+
+bool verify_all(const verify_options& options)
+{
+	if (options.sweep.enabled())
+	{
+		return run_scale_sweep(options);
+	}
+
+	if (options.batch.enabled())
+	{
+		return advent::run_batch(options);
+	}
+
+	if (options.read_stdin)
+	{
+		return advent::solve_from_stdin(options.day, options.part);
+	}
+
+	if (!options.server_socket_path.empty())
+	{
+		if (!advent::can_run_server())
+		{
+			std::cerr << "Server mode needs Unix domain sockets, which are not available here.\n";
+			return false;
+		}
+		return advent::run_server(options.server_socket_path, options.num_threads);
+	}
+
+	test_results results;
+	const auto wall_start_time = std::chrono::high_resolution_clock::now();
+	if (options.num_threads == 1)
+	{
+		run_tests_serial(options, results);
+	}
+	else
+	{
+		run_tests_parallel(options, results);
+	}
+	const std::chrono::nanoseconds wall_time = std::chrono::high_resolution_clock::now() - wall_start_time;
 
-	auto result_to_string = [&filter](const test_result& result)
+	auto result_to_string = [&options](const test_result& result)
 	{
 		std::ostringstream oss;
-		oss << result.name << ": " << result.result << " - ";
+		oss << result.name << ": ";
+		if (result.status != test_status::timeout && result.status != test_status::crash)
+		{
+			oss << result.result << " - ";
+		}
 		switch (result.status)
 		{
 		case test_status::pass:
 			oss << "PASS\n";
 			break;
 		case test_status::fail:
-			oss << "FAIL (expected " << result.expected << ")\n";
+			if (result.memory.has_value() && result.memory->exceeded_limit)
+			{
+				oss << "FAIL (exceeded the memory limit of " << options.memory_limit_mb << " MiB)\n";
+			}
+			else
+			{
+				oss << "FAIL (expected " << result.expected << ")\n";
+			}
 			break;
+		case test_status::timeout:
+		case test_status::crash:
+			oss << result.result << '\n';
+			return oss.str();
 		case test_status::filtered:
 			return std::string{ "" };
 		default: // unknown
 			oss << "[Unknown]\n";
 			break;
 		}
+		if (result.benchmark.has_value())
+		{
+			oss << "    " << to_string(*result.benchmark) << '\n';
+		}
+		if (result.counters.has_value())
+		{
+			oss << "    " << to_string(*result.counters) << '\n';
+		}
+		if (result.allocations.has_value())
+		{
+			oss << "    " << to_string(*result.allocations) << '\n';
+		}
+		if (result.memory.has_value())
+		{
+			oss << "    " << to_string(*result.memory) << '\n';
+		}
+		if (options.zones && result.zones.has_value())
+		{
+			oss << "    " << to_string(*result.zones) << '\n';
+		}
 		return oss.str();
 	};
 
@@ -268,43 +1072,41 @@ bool verify_all(const std::vector<std::string_view>& filter)
 		"RESULTS:\n"
 		"    PASSED : " << get_count(check_result<test_status::pass>) << "\n"
 		"    FAILED : " << get_count(check_result<test_status::fail>) << "\n"
-		"    UNKNOWN: " << get_count(check_result<test_status::unknown>) << "\n"
-		"    TIME   : " << to_human_readable(total_time) << '\n';
-	return std::ranges::none_of(results,check_result<test_status::fail>);
-}
-
-verification_test make_test(std::string name, TestFunc func, int64_t result)
-{
-	return make_test(std::move(name), func, std::to_string(result));
-}
-
-verification_test make_test(std::string name, TestFunc func, std::string result)
-{
-	return verification_test{ std::move(name),func,std::move(result) };
-}
-
-verification_test make_test(std::string name, TestFunc func, Dummy)
-{
-	return verification_test{ std::move(name),func };
-}
-
-verification_test make_test(std::string name, TestFuncWithArg func, int64_t result, std::string arg)
-{
-	return make_test(std::move(name), func, std::to_string(result), std::move(arg));
-}
-
-verification_test make_test(std::string name, TestFuncWithArg func, std::string result, std::string arg)
-{
-	return verification_test{std::move(name), func, std::move(arg), std::move(result)};
-}
+		"    UNKNOWN: " << get_count(check_result<test_status::unknown>) << '\n';
+	const auto num_timeouts = get_count(check_result<test_status::timeout>);
+	const auto num_crashes = get_count(check_result<test_status::crash>);
+	if (num_timeouts > 0)
+	{
+		std::cout << "    TIMEOUT: " << num_timeouts << '\n';
+	}
+	if (num_crashes > 0)
+	{
+		std::cout << "    CRASHED: " << num_crashes << '\n';
+	}
+	std::cout << "    TIME   : " << to_human_readable(total_time) << '\n';
+	if (options.num_threads != 1)
+	{
+		std::cout << "    WALL   : " << to_human_readable(wall_time) << '\n';
+	}
+	if (options.perf_counters && std::ranges::none_of(results, [](const test_result& result) { return result.counters.has_value(); }))
+	{
+		std::cout << "    (Performance counters were requested but are not available here.)\n";
+	}
+	if (options.isolating() && !advent::can_isolate_tests())
+	{
+		std::cout << "    (Tests cannot run in their own process here, so --isolate and --timeout were ignored.)\n";
+	}
+	if (options.measuring_memory() && options.num_threads != 1)
+	{
+		std::cout << "    (Resident memory is shared by tests running at the same time, so per-test figures are only approximate with -j.)\n";
+	}
 
-verification_test make_test(std::string name, TestFuncWithArg func, Dummy, std::string arg)
-{
-	return verification_test{std::move(name), func, std::move(arg)};
+	const bool exported_ok = export_results(options.export_settings, results);
+	return exported_ok && num_timeouts == 0 && num_crashes == 0 && std::ranges::none_of(results,check_result<test_status::fail>);
 }
 
-ResultType TestWithArgExecutable::execute()
+ResultType TestWithArgExecutable::execute() const
 {
-	std::istringstream iss{ std::move(arg)};
+	utils::view_istream iss{ arg };
 	return func(iss);
 }
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include <string_view>
+#include <iostream>
+#include <charconv>
+#include <optional>
+#include <chrono>
+
+#include "../advent/advent_of_code.h"
+
+namespace
+{
+	template <typename T>
+	bool parse_value(std::string_view arg, T& out)
+	{
+		const char* first = arg.data();
+		const char* last = first + arg.size();
+		const auto [ptr, ec] = std::from_chars(first, last, out);
+		return ec == std::errc{} && ptr == last;
+	}
+
+	bool parse_value(std::string_view arg, std::string_view& out)
+	{
+		out = arg;
+		return !arg.empty();
+	}
+
+	template <typename Rep, typename Period>
+	bool parse_value(std::string_view arg, std::chrono::duration<Rep, Period>& out)
+	{
+		Rep count{};
+		if (!parse_value(arg, count)) return false;
+		out = std::chrono::duration<Rep, Period>{ count };
+		return true;
+	}
+
+	enum class flag_result
+	{
+		no_match,
+		matched,
+		error
+	};
+
+	// Walks the command line. Flags take their value from the same argument ("-j4", "--bench=10")
+	// or from the one after it ("-j 4", "--bench 10").
+	class arg_reader
+	{
+		int m_argc;
+		char** m_argv;
+		int m_idx = 1;
+
+		// Short flags may have their value stuck on the end. Long flags need an '='.
+		std::optional<std::string_view> get_inline_value(std::string_view flag) const
+		{
+			const std::string_view arg = current();
+			if (!arg.starts_with(flag)) return std::nullopt;
+			std::string_view rest = arg.substr(flag.size());
+			if (rest.empty()) return rest;
+			const bool is_long_flag = flag.starts_with("--");
+			if (!is_long_flag) return rest;
+			if (rest.front() == '=') return rest.substr(1);
+			return std::nullopt;
+		}
+	public:
+		arg_reader(int argc, char** argv) : m_argc{ argc }, m_argv{ argv } {}
+		bool done() const noexcept { return m_idx >= m_argc; }
+		std::string_view current() const noexcept { return m_argv[m_idx]; }
+		void next() noexcept { ++m_idx; }
+
+		template <typename T>
+		flag_result read_flag(std::string_view flag, T& out)
+		{
+			std::optional<std::string_view> value = get_inline_value(flag);
+			if (!value.has_value()) return flag_result::no_match;
+			next();
+			if (value->empty())
+			{
+				if (done())
+				{
+					std::cerr << "Missing value after '" << flag << "'\n";
+					return flag_result::error;
+				}
+				value = current();
+				next();
+			}
+			if (!parse_value(*value, out))
+			{
+				std::cerr << "Could not read value for '" << flag << "' from '" << *value << "'\n";
+				return flag_result::error;
+			}
+			return flag_result::matched;
+		}
+
+		// Flags that are either there or not, like "--perf".
+		flag_result read_switch(std::string_view flag, bool& out)
+		{
+			if (current() != flag) return flag_result::no_match;
+			out = true;
+			next();
+			return flag_result::matched;
+		}
+	};
+}
+
+std::optional<verify_options> parse_verify_options(int argc, char** argv)
+{
+	verify_options result;
+	arg_reader reader{ argc, argv };
+	bool failed = false;
+	auto handled = [&failed](flag_result fr)
+	{
+		failed = failed || (fr == flag_result::error);
+		return fr != flag_result::no_match;
+	};
+
+	while (!reader.done() && !failed)
+	{
+		if (handled(reader.read_flag("-j", result.num_threads))) continue;
+		if (handled(reader.read_flag("--bench-time", result.benchmark.time_budget))) continue;
+		if (handled(reader.read_flag("--bench", result.benchmark.max_runs))) continue;
+		if (handled(reader.read_flag("--warmup", result.benchmark.warmup_runs))) continue;
+		if (handled(reader.read_flag("--export", result.export_settings.output_path))) continue;
+		if (handled(reader.read_flag("--baseline", result.export_settings.baseline_path))) continue;
+		if (handled(reader.read_flag("--regression-threshold", result.export_settings.regression_threshold_percent))) continue;
+		if (handled(reader.read_flag("--regression-floor", result.export_settings.regression_floor))) continue;
+		if (handled(reader.read_switch("--perf", result.perf_counters))) continue;
+		if (handled(reader.read_switch("--alloc", result.allocation_stats))) continue;
+		if (handled(reader.read_switch("--zones", result.zones))) continue;
+		if (handled(reader.read_switch("--mem", result.memory_stats))) continue;
+		if (handled(reader.read_flag("--mem-limit", result.memory_limit_mb))) continue;
+		if (handled(reader.read_flag("--sweep", result.sweep.max_scale))) continue;
+		if (handled(reader.read_flag("--seed", result.sweep.seed))) continue;
+		if (handled(reader.read_flag("--trace", result.export_settings.trace_path))) continue;
+		if (handled(reader.read_switch("--isolate", result.isolate))) continue;
+		if (handled(reader.read_flag("--timeout", result.timeout))) continue;
+		if (handled(reader.read_flag("--serve", result.server_socket_path))) continue;
+		if (handled(reader.read_flag("--batch-queue", result.batch.max_queued))) continue;
+		if (handled(reader.read_flag("--batch", result.batch.input_path))) continue;
+		if (handled(reader.read_flag("--day", result.day))) continue;
+		if (handled(reader.read_flag("--part", result.part))) continue;
+		if (handled(reader.read_switch("--stdin", result.read_stdin))) continue;
+
+		const std::string_view arg = reader.current();
+		if (arg.starts_with("-"))
+		{
+			std::cerr << "Unknown option '" << arg << "'\n";
+			return std::nullopt;
+		}
+		result.filters.push_back(arg);
+		reader.next();
+	}
+
+	if (failed) return std::nullopt;
+	const bool solving_one_day = result.batch.enabled() || result.read_stdin;
+	if (solving_one_day && (result.day < 1 || result.day > 25))
+	{
+		std::cerr << "--batch and --stdin need a day from 1 to 25 (use --day N)\n";
+		return std::nullopt;
+	}
+	if (result.part < 0 || result.part > 2 || (result.read_stdin && result.part == 0))
+	{
+		std::cerr << "--part must be 1 or 2" << (result.read_stdin ? " with --stdin, which can only be read once" : "") << "\n";
+		return std::nullopt;
+	}
+	if (result.isolate && result.num_threads != 1 && result.timeout.count() == 0)
+	{
+		std::cerr << "--isolate with -j needs --timeout: a test forked while another thread holds a lock can hang\n";
+		return std::nullopt;
+	}
+	return result;
+}
\ No newline at end of file
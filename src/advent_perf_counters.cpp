@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+
+#include "../advent/advent_perf_counters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	constexpr int NO_COUNTER = -1;
+
+#ifdef __linux__
+	struct counter_config
+	{
+		std::uint32_t type;
+		std::uint64_t config;
+	};
+
+	// In the same order as the fields of perf_counter_values.
+	constexpr std::array<counter_config, 5> COUNTER_CONFIGS{
+		counter_config{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+		counter_config{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+		counter_config{ PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+		counter_config{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+		counter_config{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES }
+	};
+
+	int open_counter(const counter_config& cfg)
+	{
+		perf_event_attr attr{};
+		attr.size = sizeof(attr);
+		attr.type = cfg.type;
+		attr.config = cfg.config;
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+		const long fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+		return fd < 0 ? NO_COUNTER : static_cast<int>(fd);
+	}
+
+	// If there are more counters than the hardware has room for, the kernel takes turns with them,
+	// so scale up by how long this one was actually running.
+	std::optional<std::uint64_t> read_counter(int fd)
+	{
+		struct
+		{
+			std::uint64_t value;
+			std::uint64_t time_enabled;
+			std::uint64_t time_running;
+		} data{};
+		if (::read(fd, &data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) return std::nullopt;
+		if (data.time_running == 0) return std::nullopt;
+		if (data.time_running == data.time_enabled) return data.value;
+		const double scale = static_cast<double>(data.time_enabled) / static_cast<double>(data.time_running);
+		return static_cast<std::uint64_t>(std::llround(static_cast<double>(data.value) * scale));
+	}
+#endif
+}
+
+advent::perf_counters::perf_counters()
+{
+	m_fds.fill(NO_COUNTER);
+#ifdef __linux__
+	std::ranges::transform(COUNTER_CONFIGS, begin(m_fds), open_counter);
+#endif
+}
+
+advent::perf_counters::~perf_counters()
+{
+#ifdef __linux__
+	for (int fd : m_fds)
+	{
+		if (fd != NO_COUNTER) ::close(fd);
+	}
+#endif
+}
+
+bool advent::perf_counters::available() const noexcept
+{
+	return std::ranges::any_of(m_fds, [](int fd) { return fd != NO_COUNTER; });
+}
+
+void advent::perf_counters::start() noexcept
+{
+#ifdef __linux__
+	for (int fd : m_fds)
+	{
+		if (fd == NO_COUNTER) continue;
+		::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+		::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+	}
+#endif
+}
+
+perf_counter_values advent::perf_counters::stop() noexcept
+{
+	perf_counter_values result;
+#ifdef __linux__
+	for (int fd : m_fds)
+	{
+		if (fd != NO_COUNTER) ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+	}
+	auto read = [this](std::size_t idx)
+	{
+		return m_fds[idx] != NO_COUNTER ? read_counter(m_fds[idx]) : std::nullopt;
+	};
+	result.cycles = read(0);
+	result.instructions = read(1);
+	result.l1d_misses = read(2);
+	result.llc_misses = read(3);
+	result.branch_misses = read(4);
+#endif
+	return result;
+}
+
+advent::perf_counters& advent::get_thread_perf_counters()
+{
+	thread_local perf_counters counters;
+	return counters;
+}
\ No newline at end of file
@@ -0,0 +1,703 @@
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <charconv>
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <utility>
+
+#include "../advent/advent_results_export.h"
+
+namespace
+{
+	// One value in an exported record. Numbers are written unquoted in JSON.
+	struct field
+	{
+		std::string_view key;
+		std::string value;
+		bool is_number = false;
+	};
+
+	using record = std::vector<field>;
+	using parsed_record = std::map<std::string, std::string, std::less<>>;
+
+	// The columns, in order. Benchmark, counter and allocation columns are left blank for tests that did not record them.
+	constexpr std::string_view FIELD_NAMES[] = {
+		"name", "status", "result", "expected", "time_ns",
+		"runs", "min_ns", "median_ns", "p95_ns", "mean_ns", "stddev_ns", "allocations_per_run",
+		"cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses",
+		"allocations", "bytes_allocated", "peak_live_bytes",
+		"peak_rss_bytes", "rss_increase_bytes"
+	};
+
+	// The perf_counter_values members with their column names.
+	constexpr std::pair<std::string_view, std::optional<std::uint64_t> perf_counter_values::*> COUNTER_FIELDS[] = {
+		{ "cycles", &perf_counter_values::cycles },
+		{ "instructions", &perf_counter_values::instructions },
+		{ "l1d_misses", &perf_counter_values::l1d_misses },
+		{ "llc_misses", &perf_counter_values::llc_misses },
+		{ "branch_misses", &perf_counter_values::branch_misses }
+	};
+
+	// The memory_usage members with their column names.
+	constexpr std::pair<std::string_view, std::optional<std::size_t> memory_usage::*> MEMORY_FIELDS[] = {
+		{ "peak_rss_bytes", &memory_usage::peak_rss_bytes },
+		{ "rss_increase_bytes", &memory_usage::rss_increase_bytes }
+	};
+
+	// The allocation_summary members with their column names.
+	constexpr std::pair<std::string_view, std::size_t allocation_summary::*> ALLOCATION_FIELDS[] = {
+		{ "allocations", &allocation_summary::num_allocations },
+		{ "bytes_allocated", &allocation_summary::bytes_allocated },
+		{ "peak_live_bytes", &allocation_summary::peak_live_bytes }
+	};
+
+	std::string_view to_string(test_status status)
+	{
+		switch (status)
+		{
+		case test_status::pass: return "pass";
+		case test_status::fail: return "fail";
+		case test_status::filtered: return "filtered";
+		case test_status::timeout: return "timeout";
+		case test_status::crash: return "crash";
+		default: return "unknown";
+		}
+	}
+
+	test_status to_status(std::string_view str)
+	{
+		if (str == "pass") return test_status::pass;
+		if (str == "fail") return test_status::fail;
+		if (str == "filtered") return test_status::filtered;
+		if (str == "timeout") return test_status::timeout;
+		if (str == "crash") return test_status::crash;
+		return test_status::unknown;
+	}
+
+	template <typename T>
+	std::string number_string(T value)
+	{
+		std::ostringstream oss;
+		oss << value;
+		return oss.str();
+	}
+
+	record make_record(const test_result& result)
+	{
+		record rec;
+		rec.push_back(field{ "name", result.name });
+		rec.push_back(field{ "status", std::string{ to_string(result.status) } });
+		rec.push_back(field{ "result", result.result });
+		rec.push_back(field{ "expected", result.expected });
+		rec.push_back(field{ "time_ns", number_string(result.time_taken.count()), true });
+		if (result.benchmark.has_value())
+		{
+			const benchmark_stats& bench = *result.benchmark;
+			rec.push_back(field{ "runs", number_string(bench.num_runs), true });
+			rec.push_back(field{ "min_ns", number_string(bench.min.count()), true });
+			rec.push_back(field{ "median_ns", number_string(bench.median.count()), true });
+			rec.push_back(field{ "p95_ns", number_string(bench.p95.count()), true });
+			rec.push_back(field{ "mean_ns", number_string(bench.mean.count()), true });
+			rec.push_back(field{ "stddev_ns", number_string(bench.stddev.count()), true });
+			rec.push_back(field{ "allocations_per_run", number_string(bench.allocations_per_run), true });
+		}
+		if (result.counters.has_value())
+		{
+			for (const auto& [key, member] : COUNTER_FIELDS)
+			{
+				const std::optional<std::uint64_t>& value = (*result.counters).*member;
+				if (value.has_value())
+				{
+					rec.push_back(field{ key, number_string(*value), true });
+				}
+			}
+		}
+		if (result.allocations.has_value())
+		{
+			for (const auto& [key, member] : ALLOCATION_FIELDS)
+			{
+				rec.push_back(field{ key, number_string((*result.allocations).*member), true });
+			}
+		}
+		if (result.memory.has_value())
+		{
+			for (const auto& [key, member] : MEMORY_FIELDS)
+			{
+				const std::optional<std::size_t>& value = (*result.memory).*member;
+				if (value.has_value())
+				{
+					rec.push_back(field{ key, number_string(*value), true });
+				}
+			}
+		}
+		return rec;
+	}
+
+	template <typename T>
+	bool read_number(const parsed_record& rec, std::string_view key, T& out)
+	{
+		const auto find_result = rec.find(key);
+		if (find_result == end(rec) || find_result->second.empty()) return false;
+		const std::string& str = find_result->second;
+		const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), out);
+		return ec == std::errc{};
+	}
+
+	std::string read_string(const parsed_record& rec, std::string_view key)
+	{
+		const auto find_result = rec.find(key);
+		return find_result != end(rec) ? find_result->second : std::string{};
+	}
+
+	test_result to_test_result(const parsed_record& rec)
+	{
+		auto read_ns = [&rec](std::string_view key, std::chrono::nanoseconds& out)
+		{
+			std::chrono::nanoseconds::rep count{};
+			const bool success = read_number(rec, key, count);
+			if (success) out = std::chrono::nanoseconds{ count };
+			return success;
+		};
+
+		test_result result;
+		result.name = read_string(rec, "name");
+		result.status = to_status(read_string(rec, "status"));
+		result.result = read_string(rec, "result");
+		result.expected = read_string(rec, "expected");
+		result.time_taken = std::chrono::nanoseconds{ 0 };
+		read_ns("time_ns", result.time_taken);
+
+		benchmark_stats bench;
+		if (read_number(rec, "runs", bench.num_runs))
+		{
+			read_ns("min_ns", bench.min);
+			read_ns("median_ns", bench.median);
+			read_ns("p95_ns", bench.p95);
+			read_ns("mean_ns", bench.mean);
+			read_ns("stddev_ns", bench.stddev);
+			read_number(rec, "allocations_per_run", bench.allocations_per_run);
+			result.benchmark = bench;
+		}
+
+		perf_counter_values counters;
+		for (const auto& [key, member] : COUNTER_FIELDS)
+		{
+			std::uint64_t value = 0;
+			if (read_number(rec, key, value))
+			{
+				counters.*member = value;
+			}
+		}
+		if (counters.any())
+		{
+			result.counters = counters;
+		}
+
+		allocation_summary allocations;
+		bool any_allocation_fields = false;
+		for (const auto& [key, member] : ALLOCATION_FIELDS)
+		{
+			any_allocation_fields = read_number(rec, key, allocations.*member) || any_allocation_fields;
+		}
+		if (any_allocation_fields)
+		{
+			result.allocations = allocations;
+		}
+
+		memory_usage memory;
+		for (const auto& [key, member] : MEMORY_FIELDS)
+		{
+			std::size_t value = 0;
+			if (read_number(rec, key, value))
+			{
+				memory.*member = value;
+			}
+		}
+		if (memory.peak_rss_bytes.has_value() || memory.rss_increase_bytes.has_value())
+		{
+			result.memory = memory;
+		}
+		return result;
+	}
+
+	// JSON
+
+	void write_json_string(std::ostream& output, std::string_view str)
+	{
+		output << '"';
+		for (char c : str)
+		{
+			switch (c)
+			{
+			case '"': output << "\\\""; break;
+			case '\\': output << "\\\\"; break;
+			case '\n': output << "\\n"; break;
+			case '\r': output << "\\r"; break;
+			case '\t': output << "\\t"; break;
+			default:
+				if (static_cast<unsigned char>(c) < 0x20)
+				{
+					output << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec << std::setfill(' ');
+				}
+				else
+				{
+					output << c;
+				}
+				break;
+			}
+		}
+		output << '"';
+	}
+
+	void write_json(std::ostream& output, std::span<const test_result> results)
+	{
+		output << "[\n";
+		bool first_record = true;
+		for (const test_result& result : results)
+		{
+			if (result.status == test_status::filtered) continue;
+			if (!first_record) output << ",\n";
+			first_record = false;
+
+			output << "  {";
+			bool first_field = true;
+			for (const field& f : make_record(result))
+			{
+				if (!first_field) output << ", ";
+				first_field = false;
+				write_json_string(output, f.key);
+				output << ": ";
+				if (f.is_number)
+				{
+					output << f.value;
+				}
+				else
+				{
+					write_json_string(output, f.value);
+				}
+			}
+			output << '}';
+		}
+		output << "\n]\n";
+	}
+
+	// Complete ("X") events with times in microseconds from the first zone, which is what chrome://tracing expects.
+	void write_chrome_trace(std::ostream& output, std::span<const test_result> results)
+	{
+		std::optional<advent::zone_clock::time_point> epoch;
+		for (const test_result& result : results)
+		{
+			if (!result.zones.has_value() || result.zones->records.empty()) continue;
+			const advent::zone_clock::time_point start = result.zones->records.front().start;
+			epoch = epoch.has_value() ? std::min(*epoch, start) : start;
+		}
+
+		auto to_us = [](std::chrono::nanoseconds ns) { return static_cast<double>(ns.count()) / 1000.0; };
+
+		output << "{\"traceEvents\": [\n";
+		bool first_event = true;
+		for (const test_result& result : results)
+		{
+			if (!result.zones.has_value()) continue;
+			for (const advent::zone_record& record : result.zones->records)
+			{
+				if (!first_event) output << ",\n";
+				first_event = false;
+				output << "  {\"name\": ";
+				write_json_string(output, record.name);
+				output << ", \"cat\": ";
+				write_json_string(output, result.name);
+				output << ", \"ph\": \"X\", \"pid\": 0, \"tid\": " << result.zones->thread_index
+					<< std::fixed << std::setprecision(3)
+					<< ", \"ts\": " << to_us(record.start - *epoch)
+					<< ", \"dur\": " << to_us(record.duration) << '}';
+				output << std::defaultfloat;
+			}
+		}
+		output << "\n], \"displayTimeUnit\": \"ns\"}\n";
+	}
+
+	// Reads the array of flat objects that write_json produces.
+	class json_reader
+	{
+		std::string_view m_text;
+		std::size_t m_pos = 0;
+
+		void skip_whitespace()
+		{
+			while (m_pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_pos])))
+			{
+				++m_pos;
+			}
+		}
+
+		bool consume(char c)
+		{
+			skip_whitespace();
+			if (m_pos < m_text.size() && m_text[m_pos] == c)
+			{
+				++m_pos;
+				return true;
+			}
+			return false;
+		}
+
+		std::optional<std::string> read_string()
+		{
+			if (!consume('"')) return std::nullopt;
+			std::string result;
+			while (m_pos < m_text.size())
+			{
+				const char c = m_text[m_pos++];
+				if (c == '"') return result;
+				if (c != '\\')
+				{
+					result.push_back(c);
+					continue;
+				}
+				if (m_pos >= m_text.size()) return std::nullopt;
+				const char escaped = m_text[m_pos++];
+				switch (escaped)
+				{
+				case 'n': result.push_back('\n'); break;
+				case 'r': result.push_back('\r'); break;
+				case 't': result.push_back('\t'); break;
+				case 'b': result.push_back('\b'); break;
+				case 'f': result.push_back('\f'); break;
+				case 'u':
+				{
+					// Only single-byte code points are ever written, so that is all that is read back.
+					if (m_pos + 4 > m_text.size()) return std::nullopt;
+					unsigned int code = 0;
+					const char* first = m_text.data() + m_pos;
+					const auto [ptr, ec] = std::from_chars(first, first + 4, code, 16);
+					if (ec != std::errc{} || ptr != first + 4 || code > 0xFF) return std::nullopt;
+					result.push_back(static_cast<char>(code));
+					m_pos += 4;
+					break;
+				}
+				default: result.push_back(escaped); break;
+				}
+			}
+			return std::nullopt;
+		}
+
+		// Numbers, true, false and null are kept as their raw text. null becomes an empty string.
+		std::optional<std::string> read_value()
+		{
+			skip_whitespace();
+			if (m_pos >= m_text.size()) return std::nullopt;
+			if (m_text[m_pos] == '"') return read_string();
+			const std::size_t start = m_pos;
+			while (m_pos < m_text.size() && m_text[m_pos] != ',' && m_text[m_pos] != '}' && !std::isspace(static_cast<unsigned char>(m_text[m_pos])))
+			{
+				++m_pos;
+			}
+			const std::string_view raw = m_text.substr(start, m_pos - start);
+			if (raw.empty()) return std::nullopt;
+			return raw == "null" ? std::string{} : std::string{ raw };
+		}
+
+		std::optional<parsed_record> read_object()
+		{
+			if (!consume('{')) return std::nullopt;
+			parsed_record result;
+			if (consume('}')) return result;
+			do
+			{
+				std::optional<std::string> key = read_string();
+				if (!key.has_value() || !consume(':')) return std::nullopt;
+				std::optional<std::string> value = read_value();
+				if (!value.has_value()) return std::nullopt;
+				result.insert_or_assign(std::move(*key), std::move(*value));
+			} while (consume(','));
+			if (!consume('}')) return std::nullopt;
+			return result;
+		}
+	public:
+		explicit json_reader(std::string_view text) : m_text{ text } {}
+
+		std::optional<std::vector<parsed_record>> read_records()
+		{
+			if (!consume('[')) return std::nullopt;
+			std::vector<parsed_record> result;
+			if (consume(']')) return result;
+			do
+			{
+				std::optional<parsed_record> rec = read_object();
+				if (!rec.has_value()) return std::nullopt;
+				result.push_back(std::move(*rec));
+			} while (consume(','));
+			if (!consume(']')) return std::nullopt;
+			return result;
+		}
+	};
+
+	// CSV (RFC 4180 quoting)
+
+	void write_csv_field(std::ostream& output, std::string_view str)
+	{
+		const bool needs_quotes = str.find_first_of(",\"\r\n") != std::string_view::npos;
+		if (!needs_quotes)
+		{
+			output << str;
+			return;
+		}
+		output << '"';
+		for (char c : str)
+		{
+			if (c == '"') output << '"';
+			output << c;
+		}
+		output << '"';
+	}
+
+	void write_csv(std::ostream& output, std::span<const test_result> results)
+	{
+		for (std::string_view name : FIELD_NAMES)
+		{
+			if (name != FIELD_NAMES[0]) output << ',';
+			output << name;
+		}
+		output << '\n';
+
+		for (const test_result& result : results)
+		{
+			if (result.status == test_status::filtered) continue;
+			const record rec = make_record(result);
+			for (std::string_view name : FIELD_NAMES)
+			{
+				if (name != FIELD_NAMES[0]) output << ',';
+				const auto find_result = std::ranges::find(rec, name, &field::key);
+				if (find_result != end(rec))
+				{
+					write_csv_field(output, find_result->value);
+				}
+			}
+			output << '\n';
+		}
+	}
+
+	// Returns nullopt if a quoted field is never closed.
+	std::optional<std::vector<std::vector<std::string>>> read_csv_rows(std::string_view text)
+	{
+		std::vector<std::vector<std::string>> rows;
+		std::vector<std::string> row;
+		std::string current;
+		bool in_quotes = false;
+		bool row_has_data = false;
+
+		for (std::size_t pos = 0; pos < text.size(); ++pos)
+		{
+			const char c = text[pos];
+			if (in_quotes)
+			{
+				if (c != '"')
+				{
+					current.push_back(c);
+				}
+				else if (pos + 1 < text.size() && text[pos + 1] == '"')
+				{
+					current.push_back('"');
+					++pos;
+				}
+				else
+				{
+					in_quotes = false;
+				}
+				continue;
+			}
+
+			switch (c)
+			{
+			case '"':
+				in_quotes = true;
+				row_has_data = true;
+				break;
+			case ',':
+				row.push_back(std::move(current));
+				current.clear();
+				row_has_data = true;
+				break;
+			case '\r':
+				break;
+			case '\n':
+				if (row_has_data || !current.empty())
+				{
+					row.push_back(std::move(current));
+					rows.push_back(std::move(row));
+				}
+				current.clear();
+				row.clear();
+				row_has_data = false;
+				break;
+			default:
+				current.push_back(c);
+				row_has_data = true;
+				break;
+			}
+		}
+
+		if (in_quotes) return std::nullopt;
+		if (row_has_data || !current.empty())
+		{
+			row.push_back(std::move(current));
+			rows.push_back(std::move(row));
+		}
+		return rows;
+	}
+
+	std::optional<std::vector<parsed_record>> read_csv_records(std::string_view text)
+	{
+		const auto rows = read_csv_rows(text);
+		if (!rows.has_value() || rows->empty()) return std::nullopt;
+		const std::vector<std::string>& header = rows->front();
+
+		std::vector<parsed_record> result;
+		for (auto it = std::next(begin(*rows)); it != end(*rows); ++it)
+		{
+			parsed_record rec;
+			for (std::size_t col = 0; col < std::min(header.size(), it->size()); ++col)
+			{
+				rec.insert_or_assign(header[col], (*it)[col]);
+			}
+			result.push_back(std::move(rec));
+		}
+		return result;
+	}
+}
+
+advent::results_format advent::get_results_format(std::string_view path)
+{
+	return path.ends_with(".csv") ? results_format::csv : results_format::json;
+}
+
+void advent::write_results(std::ostream& output, std::span<const test_result> results, results_format format)
+{
+	switch (format)
+	{
+	case results_format::csv:
+		write_csv(output, results);
+		break;
+	case results_format::json:
+	default:
+		write_json(output, results);
+		break;
+	}
+}
+
+bool advent::write_results(std::string_view path, std::span<const test_result> results)
+{
+	std::ofstream output{ std::string{ path } };
+	if (!output.is_open())
+	{
+		std::cerr << "Could not open '" << path << "' to write results\n";
+		return false;
+	}
+	write_results(output, results, get_results_format(path));
+	return output.good();
+}
+
+bool advent::write_chrome_trace(std::string_view path, std::span<const test_result> results)
+{
+	std::ofstream output{ std::string{ path } };
+	if (!output.is_open())
+	{
+		std::cerr << "Could not open '" << path << "' to write the trace\n";
+		return false;
+	}
+	::write_chrome_trace(output, results);
+	return output.good();
+}
+
+std::optional<std::vector<test_result>> advent::read_results(std::string_view path)
+{
+	std::ifstream input{ std::string{ path } };
+	if (!input.is_open())
+	{
+		std::cerr << "Could not open results file '" << path << "'\n";
+		return std::nullopt;
+	}
+	std::ostringstream contents;
+	contents << input.rdbuf();
+	auto result = parse_results(std::move(contents).str());
+	if (!result.has_value())
+	{
+		std::cerr << "Could not parse results file '" << path << "'\n";
+	}
+	return result;
+}
+
+std::optional<std::vector<test_result>> advent::parse_results(std::string_view text)
+{
+	// Decide by content rather than extension so a renamed file still loads.
+	const auto first_char = text.find_first_not_of(" \t\r\n");
+	const bool is_json = first_char != std::string_view::npos && text[first_char] == '[';
+	const auto records = is_json ? json_reader{ text }.read_records() : read_csv_records(text);
+	if (!records.has_value())
+	{
+		return std::nullopt;
+	}
+
+	std::vector<test_result> result;
+	result.reserve(records->size());
+	std::ranges::transform(*records, std::back_inserter(result), to_test_result);
+	return result;
+}
+
+std::vector<advent::timing_regression> advent::find_regressions(std::span<const test_result> results, std::span<const test_result> baseline, const export_options& options)
+{
+	auto is_timed = [](test_status status) { return status == test_status::pass || status == test_status::unknown; };
+	std::map<std::string_view, std::chrono::nanoseconds> baseline_times;
+	for (const test_result& old_result : baseline)
+	{
+		if (!is_timed(old_result.status))
+		{
+			baseline_times.erase(old_result.name);
+			continue;
+		}
+		baseline_times.insert_or_assign(old_result.name, old_result.time_taken);
+	}
+
+	const double threshold_factor = 1.0 + options.regression_threshold_percent / 100.0;
+	std::vector<timing_regression> regressions;
+	for (const test_result& result : results)
+	{
+		if (!is_timed(result.status)) continue;
+		const auto find_result = baseline_times.find(result.name);
+		if (find_result == end(baseline_times)) continue;
+
+		const std::chrono::nanoseconds old_time = find_result->second;
+		const std::chrono::nanoseconds new_time = result.time_taken;
+		const bool over_ratio = static_cast<double>(new_time.count()) > static_cast<double>(old_time.count()) * threshold_factor;
+		const bool over_floor = (new_time - old_time) >= options.regression_floor;
+		if (over_ratio && over_floor)
+		{
+			regressions.push_back(timing_regression{ result.name, old_time, new_time });
+		}
+	}
+	return regressions;
+}
+
+std::vector<advent::status_change> advent::find_status_changes(std::span<const test_result> results, std::span<const test_result> baseline)
+{
+	std::map<std::string_view, test_status> baseline_statuses;
+	for (const test_result& old_result : baseline)
+	{
+		baseline_statuses.insert_or_assign(old_result.name, old_result.status);
+	}
+
+	std::vector<status_change> changes;
+	for (const test_result& result : results)
+	{
+		if (result.status == test_status::filtered) continue;
+		const auto find_result = baseline_statuses.find(result.name);
+		if (find_result == end(baseline_statuses) || find_result->second == result.status) continue;
+		changes.push_back(status_change{ result.name, to_string(find_result->second), to_string(result.status) });
+	}
+	return changes;
+}
\ No newline at end of file
@@ -0,0 +1,344 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <charconv>
+#include <cstring>
+#include <algorithm>
+#include <optional>
+#include <exception>
+#include <memory>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <system_error>
+
+#include "../advent/advent_server.h"
+#include "../advent/advent_puzzle_solvers.h"
+#include "../advent/advent_assert.h"
+
+#include "../utils/work_stealing_pool.h"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+#ifndef _WIN32
+	// Buffered reads from a socket.
+	class socket_reader
+	{
+		int m_fd;
+		std::string m_buffer;
+		std::size_t m_pos = 0;
+
+		// Returns false at the end of the stream or on an error.
+		bool fill()
+		{
+			if (m_pos == m_buffer.size())
+			{
+				m_buffer.clear();
+				m_pos = 0;
+			}
+			char chunk[64 * 1024];
+			while (true)
+			{
+				const ssize_t num_read = ::read(m_fd, chunk, sizeof(chunk));
+				if (num_read < 0 && errno == EINTR) continue;
+				if (num_read <= 0) return false;
+				m_buffer.append(chunk, static_cast<std::size_t>(num_read));
+				return true;
+			}
+		}
+	public:
+		explicit socket_reader(int fd) : m_fd{ fd } {}
+
+		// Without the newline. Returns false if the stream ends first.
+		bool read_line(std::string& out)
+		{
+			while (true)
+			{
+				const auto newline = m_buffer.find('\n', m_pos);
+				if (newline != std::string::npos)
+				{
+					out.assign(m_buffer, m_pos, newline - m_pos);
+					m_pos = newline + 1;
+					return true;
+				}
+				if (!fill()) return false;
+			}
+		}
+
+		bool read_exact(std::size_t size, std::string& out)
+		{
+			out.clear();
+			out.reserve(size);
+			while (out.size() < size)
+			{
+				if (m_pos == m_buffer.size() && !fill()) return false;
+				const std::size_t num_to_take = std::min(size - out.size(), m_buffer.size() - m_pos);
+				out.append(m_buffer, m_pos, num_to_take);
+				m_pos += num_to_take;
+			}
+			return true;
+		}
+	};
+
+	bool write_all(int fd, std::string_view data)
+	{
+		while (!data.empty())
+		{
+			const ssize_t written = ::write(fd, data.data(), data.size());
+			if (written < 0)
+			{
+				if (errno == EINTR) continue;
+				return false;
+			}
+			data.remove_prefix(static_cast<std::size_t>(written));
+		}
+		return true;
+	}
+
+	// Far bigger than any puzzle input, but small enough that a bad header cannot exhaust memory.
+	constexpr std::size_t MAX_INPUT_SIZE = 64 * 1024 * 1024;
+
+	// Connections that send nothing for this long are closed.
+	constexpr int CONNECTION_TIMEOUT_SECONDS = 30;
+
+	struct request_header
+	{
+		int day = 0;
+		int part = 0;
+		std::size_t input_size = 0;
+	};
+
+	std::optional<request_header> parse_header(std::string_view line)
+	{
+		request_header result;
+		const char* pos = line.data();
+		const char* const last = line.data() + line.size();
+		auto read_field = [&pos, last](auto& out)
+		{
+			while (pos != last && *pos == ' ') ++pos;
+			const auto [ptr, ec] = std::from_chars(pos, last, out);
+			pos = ptr;
+			return ec == std::errc{};
+		};
+		if (!read_field(result.day) || !read_field(result.part) || !read_field(result.input_size)) return std::nullopt;
+		while (pos != last && (*pos == ' ' || *pos == '\r')) ++pos;
+		if (pos != last) return std::nullopt;
+		return result;
+	}
+
+	// Answers always fit on one line.
+	std::string to_single_line(std::string_view text_view)
+	{
+		std::string text{ text_view };
+		std::ranges::replace(text, '\n', ' ');
+		std::ranges::replace(text, '\r', ' ');
+		return text;
+	}
+
+	std::string solve_request(const request_header& header, std::string_view input)
+	{
+		const advent::puzzle_solver* const solver = advent::find_puzzle_solver(header.day, header.part);
+		if (solver == nullptr)
+		{
+			std::ostringstream oss;
+			oss << "error no solver for day " << header.day << " part " << header.part << '\n';
+			return oss.str();
+		}
+		const advent::puzzle_answer answer = advent::try_solve_puzzle(*solver, input);
+		if (answer.failed)
+		{
+			return "error " + to_single_line(answer.result) + '\n';
+		}
+		std::ostringstream oss;
+		oss << "ok " << answer.time_taken.count() << ' ' << to_single_line(answer.result) << '\n';
+		return oss.str();
+	}
+
+	// Solves one request on the pool and waits for the answer. The pool only ever sees solves, so clients
+	// that are slow to send (or just idle) cannot hold up anyone else's work.
+	std::string solve_on_pool(utils::work_stealing_pool& pool, const request_header& header, const std::string& input)
+	{
+		auto answer = std::make_shared<std::promise<std::string>>();
+		std::future<std::string> result = answer->get_future();
+		pool.submit([answer, &header, &input]()
+			{
+				// Pool tasks must not throw.
+				try
+				{
+					answer->set_value(solve_request(header, input));
+				}
+				catch (const std::exception& e)
+				{
+					answer->set_value("error " + to_single_line(e.what()) + '\n');
+				}
+			});
+		return result.get();
+	}
+
+	// Reads and answers requests until the client hangs up, sends something malformed, or goes quiet
+	// for longer than the receive timeout.
+	void serve_connection(int fd, utils::work_stealing_pool& pool)
+	{
+		try
+		{
+			socket_reader reader{ fd };
+			std::string line;
+			std::string input;
+			while (reader.read_line(line))
+			{
+				const std::optional<request_header> header = parse_header(line);
+				if (!header.has_value())
+				{
+					write_all(fd, "error expected \"DAY PART SIZE\"\n");
+					return;
+				}
+				if (header->input_size > MAX_INPUT_SIZE)
+				{
+					write_all(fd, "error input size " + std::to_string(header->input_size) + " is over the limit of " + std::to_string(MAX_INPUT_SIZE) + '\n');
+					return;
+				}
+				if (!reader.read_exact(header->input_size, input)) return;
+				if (!write_all(fd, solve_on_pool(pool, *header, input))) return;
+			}
+		}
+		catch (const std::exception& e)
+		{
+			write_all(fd, "error " + to_single_line(e.what()) + '\n');
+		}
+	}
+
+	// Connections each get their own thread. This counts them, so the server can wait for them all
+	// to finish before the pool they use goes away.
+	class connection_tracker
+	{
+		std::mutex m_lock;
+		std::condition_variable m_all_closed;
+		std::size_t m_num_open = 0;
+	public:
+		void opened()
+		{
+			std::scoped_lock lock{ m_lock };
+			++m_num_open;
+		}
+
+		void closed()
+		{
+			std::scoped_lock lock{ m_lock };
+			if (--m_num_open == 0)
+			{
+				m_all_closed.notify_all();
+			}
+		}
+
+		void wait_all_closed()
+		{
+			std::unique_lock lock{ m_lock };
+			m_all_closed.wait(lock, [this]() { return m_num_open == 0; });
+		}
+	};
+#endif
+}
+
+bool advent::can_run_server() noexcept
+{
+#ifdef _WIN32
+	return false;
+#else
+	return true;
+#endif
+}
+
+bool advent::run_server(std::string_view socket_path, std::size_t num_threads)
+{
+#ifdef _WIN32
+	AdventUnreachable();
+	return false;
+#else
+	sockaddr_un address{};
+	address.sun_family = AF_UNIX;
+	if (socket_path.size() >= sizeof(address.sun_path))
+	{
+		std::cerr << "Socket path '" << socket_path << "' is too long\n";
+		return false;
+	}
+	std::ranges::copy(socket_path, address.sun_path);
+
+	const int listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listen_fd < 0)
+	{
+		std::cerr << "Could not create a socket: " << std::strerror(errno) << '\n';
+		return false;
+	}
+	// A socket file left behind by an earlier run would stop bind from working. Anything else at the path is
+	// left alone.
+	struct stat existing {};
+	if (::lstat(address.sun_path, &existing) == 0)
+	{
+		if (!S_ISSOCK(existing.st_mode))
+		{
+			std::cerr << "Will not listen on '" << socket_path << "': something other than a socket is already there\n";
+			::close(listen_fd);
+			return false;
+		}
+		::unlink(address.sun_path);
+	}
+	if (::bind(listen_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || ::listen(listen_fd, SOMAXCONN) != 0)
+	{
+		std::cerr << "Could not listen on '" << socket_path << "': " << std::strerror(errno) << '\n';
+		::close(listen_fd);
+		return false;
+	}
+
+	// A client hanging up early should not end the server.
+	std::signal(SIGPIPE, SIG_IGN);
+
+	utils::work_stealing_pool pool{ num_threads };
+	connection_tracker connections;
+	std::cout << "Serving " << advent::get_puzzle_solvers().size() << " solvers on " << socket_path
+		<< " with " << pool.size() << " worker(s)\n" << std::flush;
+	while (true)
+	{
+		const int client_fd = ::accept(listen_fd, nullptr, nullptr);
+		if (client_fd < 0)
+		{
+			if (errno == EINTR || errno == ECONNABORTED) continue;
+			std::cerr << "Could not accept a connection: " << std::strerror(errno) << '\n';
+			break;
+		}
+		const timeval receive_timeout{ .tv_sec = CONNECTION_TIMEOUT_SECONDS, .tv_usec = 0 };
+		::setsockopt(client_fd, SOL_SOCKET, SO_RCVTIMEO, &receive_timeout, sizeof(receive_timeout));
+		connections.opened();
+		try
+		{
+			std::thread{ [client_fd, &pool, &connections]()
+				{
+					serve_connection(client_fd, pool);
+					::close(client_fd);
+					connections.closed();
+				} }.detach();
+		}
+		catch (const std::system_error& e)
+		{
+			write_all(client_fd, "error " + to_single_line(e.what()) + '\n');
+			::close(client_fd);
+			connections.closed();
+		}
+	}
+	connections.wait_all_closed();
+	pool.wait_idle();
+	::close(listen_fd);
+	::unlink(address.sun_path);
+	return false;
+#endif
+}
\ No newline at end of file
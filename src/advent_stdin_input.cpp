@@ -0,0 +1,61 @@
+#include <iostream>
+#include <streambuf>
+#include <vector>
+#include <chrono>
+#include <cerrno>
+
+#include "../advent/advent_stdin_input.h"
+#include "../advent/advent_puzzle_solvers.h"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace
+{
+	// Reads stdin straight from its file descriptor, a chunk at a time. Unlike std::cin's buffer (which may be
+	// kept in step with C stdio one character at a time), each refill takes whatever has arrived, up to a chunk.
+	class stdin_streambuf : public std::streambuf
+	{
+		std::vector<char> m_chunk;
+	protected:
+		int_type underflow() override
+		{
+			if (gptr() < egptr()) return traits_type::to_int_type(*gptr());
+			while (true)
+			{
+#ifdef _WIN32
+				const int num_read = ::_read(0, m_chunk.data(), static_cast<unsigned int>(m_chunk.size()));
+#else
+				const ssize_t num_read = ::read(STDIN_FILENO, m_chunk.data(), m_chunk.size());
+#endif
+				if (num_read < 0 && errno == EINTR) continue;
+				if (num_read <= 0) return traits_type::eof();
+				setg(m_chunk.data(), m_chunk.data(), m_chunk.data() + num_read);
+				return traits_type::to_int_type(*gptr());
+			}
+		}
+	public:
+		explicit stdin_streambuf(std::size_t chunk_size = 64 * 1024) : m_chunk(chunk_size) {}
+	};
+}
+
+bool advent::solve_from_stdin(int day, int part)
+{
+	const puzzle_solver* const solver = find_puzzle_solver(day, part);
+	if (solver == nullptr)
+	{
+		std::cerr << "There is no solver for day " << day << " part " << part << " in this build.\n";
+		return false;
+	}
+
+	stdin_streambuf buffer;
+	std::istream input{ &buffer };
+	const puzzle_answer answer = try_solve_puzzle(*solver, input);
+	const auto time_us = std::chrono::duration_cast<std::chrono::microseconds>(answer.time_taken).count();
+	std::cout << "Day " << day << " part " << part << (solver->solve_stream != nullptr ? " (streamed)" : "") << ": "
+		<< (answer.failed ? "ERROR: " : "") << answer.result << " in " << time_us << "us\n";
+	return !answer.failed;
+}
\ No newline at end of file
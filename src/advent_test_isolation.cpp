@@ -0,0 +1,233 @@
+#include <iostream>
+#include <sstream>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <mutex>
+#include <algorithm>
+
+#include "../advent/advent_test_isolation.h"
+#include "../advent/advent_results_export.h"
+#include "../advent/advent_assert.h"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#ifndef _WIN32
+namespace
+{
+	// Keeps going until everything is written or the pipe breaks.
+	bool write_all(int fd, std::string_view data)
+	{
+		while (!data.empty())
+		{
+			const ssize_t written = ::write(fd, data.data(), data.size());
+			if (written < 0)
+			{
+				if (errno == EINTR) continue;
+				return false;
+			}
+			data.remove_prefix(static_cast<std::size_t>(written));
+		}
+		return true;
+	}
+
+	// The child's message is the length of its output as 8 bytes, the output, then its result in the results file format.
+	[[noreturn]] void run_child(int fd, const std::function<test_result()>& run_test)
+	{
+		std::ostringstream output;
+		std::cout.rdbuf(output.rdbuf());
+		const test_result result = run_test();
+
+		std::ostringstream message;
+		const std::string output_text = std::move(output).str();
+		const std::uint64_t output_size = output_text.size();
+		message.write(reinterpret_cast<const char*>(&output_size), sizeof(output_size));
+		message << output_text;
+		advent::write_results(message, std::span{ &result, 1 }, advent::results_format::json);
+		const bool sent = write_all(fd, std::move(message).str());
+		::close(fd);
+
+		// Skip static destructors and atexit handlers: they belong to the parent.
+		::_exit(sent ? 0 : 1);
+	}
+
+	enum class read_outcome
+	{
+		finished,
+		timed_out,
+		failed
+	};
+
+	// Reads from fd until the other end closes it or the deadline passes.
+	read_outcome read_until_closed(int fd, std::optional<std::chrono::steady_clock::time_point> deadline, std::string& out)
+	{
+		char buffer[4096];
+		while (true)
+		{
+			int timeout_ms = -1;
+			if (deadline.has_value())
+			{
+				const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(*deadline - std::chrono::steady_clock::now());
+				if (remaining.count() <= 0) return read_outcome::timed_out;
+				timeout_ms = static_cast<int>(std::min<std::chrono::milliseconds::rep>(remaining.count(), 1'000'000));
+			}
+
+			pollfd pfd{ fd, POLLIN, 0 };
+			const int num_ready = ::poll(&pfd, 1, timeout_ms);
+			if (num_ready < 0)
+			{
+				if (errno == EINTR) continue;
+				return read_outcome::failed;
+			}
+			if (num_ready == 0) continue; // Check the deadline again.
+
+			const ssize_t num_read = ::read(fd, buffer, sizeof(buffer));
+			if (num_read < 0)
+			{
+				if (errno == EINTR) continue;
+				return read_outcome::failed;
+			}
+			if (num_read == 0) return read_outcome::finished;
+			out.append(buffer, static_cast<std::size_t>(num_read));
+		}
+	}
+
+	// Splits the child's message into its output and its result. Returns nullopt if it is incomplete.
+	std::optional<test_result> read_child_message(std::string_view message, std::string& output)
+	{
+		std::uint64_t output_size = 0;
+		if (message.size() < sizeof(output_size)) return std::nullopt;
+		std::memcpy(&output_size, message.data(), sizeof(output_size));
+		message.remove_prefix(sizeof(output_size));
+		if (message.size() < output_size) return std::nullopt;
+		output = message.substr(0, output_size);
+		message.remove_prefix(output_size);
+
+		std::optional<std::vector<test_result>> results = advent::parse_results(message);
+		if (!results.has_value() || results->size() != 1) return std::nullopt;
+		return std::move(results->front());
+	}
+
+	std::string describe_exit(int wait_status)
+	{
+		std::ostringstream oss;
+		if (WIFSIGNALED(wait_status))
+		{
+			const int signal = WTERMSIG(wait_status);
+			oss << "CRASH (signal " << signal;
+			if (const char* description = ::strsignal(signal))
+			{
+				oss << ": " << description;
+			}
+			oss << ')';
+		}
+		else if (WIFEXITED(wait_status))
+		{
+			oss << "CRASH (exited with code " << WEXITSTATUS(wait_status) << " before giving a result)";
+		}
+		else
+		{
+			oss << "CRASH (lost track of the test process)";
+		}
+		return oss.str();
+	}
+}
+#endif
+
+bool advent::can_isolate_tests() noexcept
+{
+#ifdef _WIN32
+	return false;
+#else
+	return true;
+#endif
+}
+
+test_result advent::run_isolated(std::string_view name, const std::optional<std::string>& expected,
+	std::chrono::milliseconds timeout, const std::function<test_result()>& run_test)
+{
+#ifdef _WIN32
+	AdventUnreachable();
+	return test_result{};
+#else
+	test_result failed_result{ std::string{ name }, "", expected.value_or(""), test_status::crash, std::chrono::nanoseconds{ 0 } };
+
+	// Anything still buffered would otherwise be written twice: once by each process.
+	std::cout.flush();
+	std::fflush(nullptr);
+
+	int fds[2];
+	pid_t child = -1;
+	const auto start_time = std::chrono::steady_clock::now();
+	{
+		// With tests running in parallel, a child forked by another thread while this pipe's write end is open
+		// would keep it open, and this test would not see its own child finish until that one did too.
+		static std::mutex fork_mutex;
+		std::scoped_lock lock{ fork_mutex };
+		if (::pipe(fds) != 0)
+		{
+			failed_result.result = std::string{ "CRASH (could not create a pipe: " } + std::strerror(errno) + ')';
+			return failed_result;
+		}
+
+		child = ::fork();
+		if (child == 0)
+		{
+			::close(fds[0]);
+			run_child(fds[1], run_test);
+		}
+		::close(fds[1]);
+	}
+	if (child < 0)
+	{
+		failed_result.result = std::string{ "CRASH (could not start a process: " } + std::strerror(errno) + ')';
+		::close(fds[0]);
+		return failed_result;
+	}
+
+	std::optional<std::chrono::steady_clock::time_point> deadline;
+	if (timeout.count() > 0)
+	{
+		deadline = start_time + timeout;
+	}
+	std::string message;
+	const read_outcome outcome = read_until_closed(fds[0], deadline, message);
+	::close(fds[0]);
+
+	if (outcome != read_outcome::finished)
+	{
+		::kill(child, SIGKILL);
+	}
+	int wait_status = 0;
+	while (::waitpid(child, &wait_status, 0) < 0 && errno == EINTR) {}
+
+	if (outcome == read_outcome::timed_out)
+	{
+		std::ostringstream oss;
+		oss << "TIMEOUT (after " << timeout.count() << "ms)";
+		failed_result.result = oss.str();
+		failed_result.status = test_status::timeout;
+		failed_result.time_taken = timeout;
+		return failed_result;
+	}
+
+	std::string output;
+	std::optional<test_result> result = read_child_message(message, output);
+	std::cout << output;
+	const bool exited_cleanly = WIFEXITED(wait_status) && WEXITSTATUS(wait_status) == 0;
+	if (!result.has_value() || !exited_cleanly)
+	{
+		failed_result.result = describe_exit(wait_status);
+		failed_result.time_taken = std::chrono::steady_clock::now() - start_time;
+		return failed_result;
+	}
+	return std::move(*result);
+#endif
+}
\ No newline at end of file
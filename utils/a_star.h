@@ -4,119 +4,268 @@
 #include <algorithm>
 #include <cassert>
 #include <iterator>
+#include <concepts>
+#include <functional>
+#include <limits>
+#include <unordered_map>
 
-#include "swap_remove.h"
-#include "sorted_vector.h"
+#include "indexed_priority_queue.h"
 
 namespace utils
 {
-	// NodeType: An arbitrary node. No particular requirements. User provided functors are used to interact.
-	// IsEndPointFunc: A function bool f(Node) that returns true if the argument is an end-point.
-	// GetNextNodesFunc: Return any iterable type containing NodeTypes that can be reached from a NodeType argument.
-	// GetCostBetweenNodesFunc: Functor with the signature: CostType f(NodeType,NodeType).
-	// GetHeuristicForNode: Functor with CostType f(NodeType) to get the heuristic.
-	// AreNodesEqual: A function bool f(NodeType,NodeType) that returns true if both nodes are equal
-	template <
-		typename NodeType,
-		typename IsEndPointFunc,
-		typename GetNextNodesFunc,
-		typename GetCostBetweenNodesFunc,
-		typename GetHeuristicForNode,
-		typename AreNodesEqual>
-		auto a_star(
-			const NodeType& start_point,
-			const IsEndPointFunc& is_end_point,
-			const GetNextNodesFunc& get_next_nodes,
-			const GetCostBetweenNodesFunc& get_cost_between_nodes,
-			const GetHeuristicForNode& get_heuristic,
-			const AreNodesEqual& are_nodes_equal,
-			std::size_t estimated_number_of_nodes = 1)
+	namespace a_star_internal
 	{
 		using ID = std::size_t;
-		using CostType = decltype(get_cost_between_nodes(start_point, start_point));
-		struct AStarNode
+		constexpr ID NO_ID = std::numeric_limits<ID>::max();
+
+		template <typename T>
+		concept std_hashable = requires(const T& t) { { std::hash<T>{}(t) } -> std::convertible_to<std::size_t>; };
+
+		// Node lookups map each node seen so far to a dense ID.
+		// They all provide: ID find(const NodeType&) const (NO_ID if not found) and void add(const NodeType&, ID).
+
+		// Checks every node seen so far. Only used if there's no better option.
+		template <typename NodeType, typename AreNodesEqual>
+		class linear_node_lookup
 		{
-			NodeType node;
-			CostType cost;
-			CostType with_heuristic;
-			ID id;
-			ID previous_id;
+			std::vector<NodeType> m_nodes;
+			const AreNodesEqual& m_are_nodes_equal;
+		public:
+			linear_node_lookup(const AreNodesEqual& are_nodes_equal, std::size_t estimated_number_of_nodes) : m_are_nodes_equal{ are_nodes_equal }
+			{
+				m_nodes.reserve(estimated_number_of_nodes);
+			}
+			ID find(const NodeType& node) const
+			{
+				const auto find_result = std::find_if(begin(m_nodes), end(m_nodes), [&node, this](const NodeType& other)
+					{
+						return m_are_nodes_equal(node, other);
+					});
+				return find_result != end(m_nodes) ? static_cast<ID>(std::distance(begin(m_nodes), find_result)) : NO_ID;
+			}
+			void add(const NodeType& node, ID id)
+			{
+				assert(id == m_nodes.size());
+				m_nodes.push_back(node);
+			}
 		};
 
-		ID latest_id = 0;
-		auto checked_nodes = utils::make_sorted_vector<AStarNode>([](const AStarNode & l, const AStarNode & r)
+		template <typename NodeType, typename HashNode, typename AreNodesEqual>
+		class hashed_node_lookup
 		{
-			return l.id < r.id;
-		});
+			struct hash_ref
+			{
+				const HashNode* func;
+				std::size_t operator()(const NodeType& node) const { return (*func)(node); }
+			};
+			struct equal_ref
+			{
+				const AreNodesEqual* func;
+				bool operator()(const NodeType& l, const NodeType& r) const { return (*func)(l, r); }
+			};
+			std::unordered_map<NodeType, ID, hash_ref, equal_ref> m_ids;
+		public:
+			hashed_node_lookup(const HashNode& hash_node, const AreNodesEqual& are_nodes_equal, std::size_t estimated_number_of_nodes)
+				: m_ids(estimated_number_of_nodes, hash_ref{ &hash_node }, equal_ref{ &are_nodes_equal })
+			{}
+			ID find(const NodeType& node) const
+			{
+				const auto find_result = m_ids.find(node);
+				return find_result != end(m_ids) ? find_result->second : NO_ID;
+			}
+			void add(const NodeType& node, ID id)
+			{
+				m_ids.emplace(node, id);
+			}
+		};
 
-		auto get_checked_node_by_id = [&checked_nodes](ID id) -> AStarNode&
+		template <typename NodeType, typename GetNodeIndex>
+		class indexed_node_lookup
 		{
-			AStarNode dummy;
-			dummy.id = id;
-			const auto find_result = checked_nodes.find(dummy);
-			assert(find_result != end(checked_nodes));
-			return *find_result;
+			std::vector<ID> m_ids;
+			const GetNodeIndex& m_get_node_index;
+		public:
+			indexed_node_lookup(const GetNodeIndex& get_node_index, std::size_t num_indices)
+				: m_ids(num_indices, NO_ID), m_get_node_index{ get_node_index }
+			{}
+			ID find(const NodeType& node) const
+			{
+				const std::size_t idx = m_get_node_index(node);
+				assert(idx < m_ids.size());
+				return m_ids[idx];
+			}
+			void add(const NodeType& node, ID id)
+			{
+				const std::size_t idx = m_get_node_index(node);
+				assert(idx < m_ids.size());
+				m_ids[idx] = id;
+			}
 		};
 
-		auto nodes_to_search = utils::make_sorted_vector<AStarNode>([](const AStarNode& l, const AStarNode& r)
+		template <
+			typename NodeType,
+			typename IsEndPointFunc,
+			typename GetNextNodesFunc,
+			typename GetCostBetweenNodesFunc,
+			typename GetHeuristicForNode,
+			typename NodeLookup>
+		auto a_star_impl(
+			const NodeType& start_point,
+			const IsEndPointFunc& is_end_point,
+			const GetNextNodesFunc& get_next_nodes,
+			const GetCostBetweenNodesFunc& get_cost_between_nodes,
+			const GetHeuristicForNode& get_heuristic,
+			NodeLookup& node_lookup,
+			std::size_t estimated_number_of_nodes)
 		{
-			return l.with_heuristic > r.with_heuristic;
-		});
-		nodes_to_search.reserve(estimated_number_of_nodes);
-		checked_nodes.reserve(estimated_number_of_nodes);
+			using CostType = decltype(get_cost_between_nodes(start_point, start_point));
+			struct AStarNode
+			{
+				NodeType node;
+				CostType cost;
+				CostType heuristic;
+				ID previous_id;
+				bool checked;
+			};
 
-		nodes_to_search.insert(AStarNode{ start_point,0,0,++latest_id,0 });
+			// Nodes are stored by ID, and the open set holds IDs keyed on cost + heuristic.
+			std::vector<AStarNode> nodes;
+			nodes.reserve(estimated_number_of_nodes);
+			utils::indexed_priority_queue<CostType> nodes_to_search{ estimated_number_of_nodes };
 
-		while (!nodes_to_search.empty())
-		{
-			AStarNode current_node = std::move(nodes_to_search.back());
-			nodes_to_search.pop_back();
+			node_lookup.add(start_point, 0);
+			nodes.push_back(AStarNode{ start_point, CostType{}, get_heuristic(start_point), NO_ID, false });
+			nodes_to_search.push(0, nodes.front().heuristic);
 
-			// Handle end-point
-			if (is_end_point(current_node.node))
+			while (!nodes_to_search.empty())
 			{
-				std::vector<NodeType> result;
-				const auto final_cost = current_node.cost;
-				while (true)
+				const ID current_id = nodes_to_search.pop();
+				nodes[current_id].checked = true;
+
+				// Handle end-point
+				if (is_end_point(nodes[current_id].node))
 				{
-					result.push_back(std::move(current_node.node));
-					if (current_node.previous_id == 0)
+					std::vector<NodeType> result;
+					const auto final_cost = nodes[current_id].cost;
+					for (ID id = current_id; id != NO_ID; id = nodes[id].previous_id)
 					{
-						std::reverse(begin(result), end(result));
-						return std::make_pair(result, final_cost);
+						result.push_back(std::move(nodes[id].node));
 					}
-					current_node = get_checked_node_by_id(current_node.previous_id);
+					std::reverse(begin(result), end(result));
+					return std::make_pair(result, final_cost);
 				}
 
-			}
-
-			// Get next nodes
-			auto next_nodes = get_next_nodes(current_node.node);
-			for (auto& n : next_nodes)
-			{
-				const auto prev_node_check = std::any_of(begin(checked_nodes), end(checked_nodes),
-					[&n,&are_nodes_equal](const AStarNode& asn)
+				// Get next nodes. Note that adding nodes may move nodes[current_id].
+				auto next_nodes = get_next_nodes(nodes[current_id].node);
+				for (auto& n : next_nodes)
 				{
-					return are_nodes_equal(n, asn.node);
-				});
-				if (prev_node_check)
-				{
-					continue;
+					const CostType cost = nodes[current_id].cost + get_cost_between_nodes(nodes[current_id].node, n);
+					const ID existing_id = node_lookup.find(n);
+					if (existing_id == NO_ID)
+					{
+						const ID new_id = nodes.size();
+						node_lookup.add(n, new_id);
+						const CostType heuristic = get_heuristic(n);
+						nodes.push_back(AStarNode{ std::move(n), cost, heuristic, current_id, false });
+						nodes_to_search.push(new_id, cost + heuristic);
+						continue;
+					}
+
+					AStarNode& existing = nodes[existing_id];
+					if (existing.checked || !(cost < existing.cost))
+					{
+						continue;
+					}
+					existing.cost = cost;
+					existing.previous_id = current_id;
+					nodes_to_search.decrease_key(existing_id, cost + existing.heuristic);
 				}
-				AStarNode node;
-				node.cost = current_node.cost + get_cost_between_nodes(current_node.node, n);
-				node.with_heuristic = node.cost + get_heuristic(n);
-				auto new_it = nodes_to_search.insert(nodes_to_search.upper_bound(node), std::move(node));
-				new_it->node = std::move(n);
-				new_it->previous_id = current_node.id;
-				new_it->id = ++latest_id;
 			}
 
-			// Update checked nodes
-			checked_nodes.push_back(std::move(current_node));
+			// If we run out of nodes, there's no path.
+			return std::make_pair(std::vector<NodeType>{}, CostType{});
+		}
+	}
+
+	// NodeType: An arbitrary node. No particular requirements. User provided functors are used to interact.
+	// IsEndPointFunc: A function bool f(Node) that returns true if the argument is an end-point.
+	// GetNextNodesFunc: Return any iterable type containing NodeTypes that can be reached from a NodeType argument.
+	// GetCostBetweenNodesFunc: Functor with the signature: CostType f(NodeType,NodeType).
+	// GetHeuristicForNode: Functor with CostType f(NodeType) to get the heuristic.
+	// AreNodesEqual: A function bool f(NodeType,NodeType) that returns true if both nodes are equal
+	// If std::hash<NodeType> exists it is used to find nodes that have been seen before, so it must agree with AreNodesEqual.
+	// Otherwise every node seen so far is checked, so prefer a_star_hashed or a_star_indexed for big searches.
+	template <
+		typename NodeType,
+		typename IsEndPointFunc,
+		typename GetNextNodesFunc,
+		typename GetCostBetweenNodesFunc,
+		typename GetHeuristicForNode,
+		typename AreNodesEqual>
+		auto a_star(
+			const NodeType& start_point,
+			const IsEndPointFunc& is_end_point,
+			const GetNextNodesFunc& get_next_nodes,
+			const GetCostBetweenNodesFunc& get_cost_between_nodes,
+			const GetHeuristicForNode& get_heuristic,
+			const AreNodesEqual& are_nodes_equal,
+			std::size_t estimated_number_of_nodes = 1)
+	{
+		if constexpr (a_star_internal::std_hashable<NodeType>)
+		{
+			const std::hash<NodeType> hash_node{};
+			a_star_internal::hashed_node_lookup<NodeType, std::hash<NodeType>, AreNodesEqual> lookup{ hash_node, are_nodes_equal, estimated_number_of_nodes };
+			return a_star_internal::a_star_impl(start_point, is_end_point, get_next_nodes, get_cost_between_nodes, get_heuristic, lookup, estimated_number_of_nodes);
+		}
+		else
+		{
+			a_star_internal::linear_node_lookup<NodeType, AreNodesEqual> lookup{ are_nodes_equal, estimated_number_of_nodes };
+			return a_star_internal::a_star_impl(start_point, is_end_point, get_next_nodes, get_cost_between_nodes, get_heuristic, lookup, estimated_number_of_nodes);
 		}
+	}
 
-		// If we run out of nodes, there's no path.
-		return std::make_pair(std::vector<NodeType>{}, CostType{});
+	// As a_star, but with a HashNode functor: std::size_t f(NodeType), which must agree with AreNodesEqual.
+	template <
+		typename NodeType,
+		typename IsEndPointFunc,
+		typename GetNextNodesFunc,
+		typename GetCostBetweenNodesFunc,
+		typename GetHeuristicForNode,
+		typename AreNodesEqual,
+		typename HashNode>
+		auto a_star_hashed(
+			const NodeType& start_point,
+			const IsEndPointFunc& is_end_point,
+			const GetNextNodesFunc& get_next_nodes,
+			const GetCostBetweenNodesFunc& get_cost_between_nodes,
+			const GetHeuristicForNode& get_heuristic,
+			const AreNodesEqual& are_nodes_equal,
+			const HashNode& hash_node,
+			std::size_t estimated_number_of_nodes = 1)
+	{
+		a_star_internal::hashed_node_lookup<NodeType, HashNode, AreNodesEqual> lookup{ hash_node, are_nodes_equal, estimated_number_of_nodes };
+		return a_star_internal::a_star_impl(start_point, is_end_point, get_next_nodes, get_cost_between_nodes, get_heuristic, lookup, estimated_number_of_nodes);
+	}
+
+	// As a_star, but for when every node maps to a unique index in [0,num_indices) (e.g. a grid cell).
+	// GetNodeIndex: Functor with the signature: std::size_t f(NodeType).
+	template <
+		typename NodeType,
+		typename IsEndPointFunc,
+		typename GetNextNodesFunc,
+		typename GetCostBetweenNodesFunc,
+		typename GetHeuristicForNode,
+		typename GetNodeIndex>
+		auto a_star_indexed(
+			const NodeType& start_point,
+			const IsEndPointFunc& is_end_point,
+			const GetNextNodesFunc& get_next_nodes,
+			const GetCostBetweenNodesFunc& get_cost_between_nodes,
+			const GetHeuristicForNode& get_heuristic,
+			const GetNodeIndex& get_node_index,
+			std::size_t num_indices)
+	{
+		a_star_internal::indexed_node_lookup<NodeType, GetNodeIndex> lookup{ get_node_index, num_indices };
+		return a_star_internal::a_star_impl(start_point, is_end_point, get_next_nodes, get_cost_between_nodes, get_heuristic, lookup, num_indices);
 	}
 }
\ No newline at end of file
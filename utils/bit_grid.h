@@ -0,0 +1,235 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <bit>
+#include <algorithm>
+#include <numeric>
+
+#include "../advent/advent_assert.h"
+#include "coords.h"
+
+namespace utils
+{
+	// A grid of bools packed 64 to a word, row by row. Each row starts on a fresh word.
+	// Whole-grid operations (and/or/xor, shifting every cell one step, counting) work on a word at a time,
+	// so stepping a set of reachable cells or flood filling does 64 cells per operation.
+	// Coordinates are (x,y) with 0 <= x < width and 0 <= y < height. Shifting in a direction moves every
+	// set cell by coords::dir(direction); cells that move off the grid are lost.
+	class bit_grid
+	{
+	public:
+		using word_type = std::uint64_t;
+		static constexpr int BITS_PER_WORD = 64;
+	private:
+		utils::coords m_max_point{ 0,0 };
+		std::size_t m_words_per_row = 0;
+		std::vector<word_type> m_words;
+
+		static std::size_t words_for_width(int width) noexcept
+		{
+			return static_cast<std::size_t>((width + BITS_PER_WORD - 1) / BITS_PER_WORD);
+		}
+
+		std::size_t get_word_idx(int x, int y) const noexcept
+		{
+			return static_cast<std::size_t>(y) * m_words_per_row + static_cast<std::size_t>(x / BITS_PER_WORD);
+		}
+
+		static word_type get_bit(int x) noexcept
+		{
+			return word_type{ 1 } << (x % BITS_PER_WORD);
+		}
+
+		// Bits past the end of a row must stay clear, or shifts and counts would see them.
+		word_type get_last_word_mask() const noexcept
+		{
+			const int used_bits = m_max_point.x % BITS_PER_WORD;
+			return used_bits == 0 ? ~word_type{ 0 } : (word_type{ 1 } << used_bits) - 1;
+		}
+
+		word_type* get_row(int y) noexcept { return m_words.data() + static_cast<std::size_t>(y) * m_words_per_row; }
+
+		void shift_right_one() noexcept
+		{
+			const word_type last_word_mask = get_last_word_mask();
+			for (int y = 0; y < m_max_point.y; ++y)
+			{
+				word_type* row = get_row(y);
+				for (std::size_t i = m_words_per_row; i-- > 0;)
+				{
+					const word_type carry = i > 0 ? (row[i - 1] >> (BITS_PER_WORD - 1)) : 0;
+					row[i] = (row[i] << 1) | carry;
+				}
+				row[m_words_per_row - 1] &= last_word_mask;
+			}
+		}
+
+		void shift_left_one() noexcept
+		{
+			for (int y = 0; y < m_max_point.y; ++y)
+			{
+				word_type* row = get_row(y);
+				for (std::size_t i = 0; i < m_words_per_row; ++i)
+				{
+					const word_type carry = i + 1 < m_words_per_row ? (row[i + 1] << (BITS_PER_WORD - 1)) : 0;
+					row[i] = (row[i] >> 1) | carry;
+				}
+			}
+		}
+
+		void shift_rows(bool towards_higher_y) noexcept
+		{
+			if (m_max_point.y == 0) return;
+			const std::size_t row_words = m_words_per_row;
+			if (towards_higher_y)
+			{
+				std::copy_backward(m_words.begin(), m_words.end() - row_words, m_words.end());
+				std::fill(m_words.begin(), m_words.begin() + row_words, word_type{ 0 });
+			}
+			else
+			{
+				std::copy(m_words.begin() + row_words, m_words.end(), m_words.begin());
+				std::fill(m_words.end() - row_words, m_words.end(), word_type{ 0 });
+			}
+		}
+
+		template <typename BinaryOp>
+		bit_grid& combine(const bit_grid& other, BinaryOp op) noexcept
+		{
+			AdventCheck(m_max_point == other.m_max_point);
+			for (std::size_t i = 0; i < m_words.size(); ++i)
+			{
+				m_words[i] = op(m_words[i], other.m_words[i]);
+			}
+			return *this;
+		}
+	public:
+		bit_grid() = default;
+		explicit bit_grid(utils::coords max_point)
+			: m_max_point{ max_point }
+			, m_words_per_row{ words_for_width(max_point.x) }
+			, m_words(m_words_per_row * static_cast<std::size_t>(max_point.y), word_type{ 0 })
+		{
+			AdventCheck(max_point.x >= 0 && max_point.y >= 0);
+		}
+		bit_grid(int width, int height) : bit_grid{ utils::coords{width,height} } {}
+
+		utils::coords get_max_point() const noexcept { return m_max_point; }
+		int width() const noexcept { return m_max_point.x; }
+		int height() const noexcept { return m_max_point.y; }
+
+		bool is_on_grid(int x, int y) const noexcept
+		{
+			return x >= 0 && y >= 0 && x < m_max_point.x && y < m_max_point.y;
+		}
+		bool is_on_grid(const utils::coords& c) const noexcept { return is_on_grid(c.x, c.y); }
+
+		// Adds an empty row at y == height(). Useful when the height isn't known up front.
+		void append_row()
+		{
+			m_words.resize(m_words.size() + m_words_per_row, word_type{ 0 });
+			++m_max_point.y;
+		}
+
+		bool test(const utils::coords& c) const
+		{
+			AdventCheck(is_on_grid(c));
+			return (m_words[get_word_idx(c.x, c.y)] & get_bit(c.x)) != 0;
+		}
+
+		void set(const utils::coords& c, bool value = true)
+		{
+			AdventCheck(is_on_grid(c));
+			word_type& word = m_words[get_word_idx(c.x, c.y)];
+			word = value ? (word | get_bit(c.x)) : (word & ~get_bit(c.x));
+		}
+
+		void reset(const utils::coords& c) { set(c, false); }
+		void clear() noexcept { std::fill(m_words.begin(), m_words.end(), word_type{ 0 }); }
+
+		std::size_t count() const noexcept
+		{
+			return std::accumulate(m_words.begin(), m_words.end(), std::size_t{ 0 },
+				[](std::size_t total, word_type w) { return total + static_cast<std::size_t>(std::popcount(w)); });
+		}
+
+		bool none() const noexcept { return std::all_of(m_words.begin(), m_words.end(), [](word_type w) { return w == 0; }); }
+		bool any() const noexcept { return !none(); }
+
+		bool operator==(const bit_grid& other) const noexcept = default;
+
+		bit_grid& operator&=(const bit_grid& other) noexcept { return combine(other, [](word_type l, word_type r) { return l & r; }); }
+		bit_grid& operator|=(const bit_grid& other) noexcept { return combine(other, [](word_type l, word_type r) { return l | r; }); }
+		bit_grid& operator^=(const bit_grid& other) noexcept { return combine(other, [](word_type l, word_type r) { return l ^ r; }); }
+
+		// Clears every cell that is set in other.
+		bit_grid& remove(const bit_grid& other) noexcept { return combine(other, [](word_type l, word_type r) { return l & ~r; }); }
+
+		// Moves every set cell one step in the given direction.
+		bit_grid& shift(utils::direction dir) noexcept
+		{
+			if (m_words_per_row == 0) return *this;
+			const utils::coords delta = utils::coords::dir(dir);
+			if (delta.x > 0) shift_right_one();
+			if (delta.x < 0) shift_left_one();
+			if (delta.y != 0) shift_rows(delta.y > 0);
+			return *this;
+		}
+
+		bit_grid shifted(utils::direction dir) const
+		{
+			bit_grid result = *this;
+			result.shift(dir);
+			return result;
+		}
+
+		// Every cell next to (but not diagonally next to) a set cell.
+		bit_grid neighbours() const
+		{
+			bit_grid result = shifted(utils::direction::up);
+			result |= shifted(utils::direction::down);
+			result |= shifted(utils::direction::left);
+			result |= shifted(utils::direction::right);
+			return result;
+		}
+
+		// Everything reachable from the set cells by moving up, down, left or right through passable cells.
+		bit_grid flood_fill(const bit_grid& passable) const
+		{
+			bit_grid result = *this;
+			result &= passable;
+			bit_grid frontier = result;
+			while (frontier.any())
+			{
+				frontier = frontier.neighbours();
+				frontier &= passable;
+				frontier.remove(result);
+				result |= frontier;
+			}
+			return result;
+		}
+
+		template <typename Func>
+		void for_each_set(const Func& func) const
+		{
+			for (int y = 0; y < m_max_point.y; ++y)
+			{
+				for (std::size_t i = 0; i < m_words_per_row; ++i)
+				{
+					word_type word = m_words[static_cast<std::size_t>(y) * m_words_per_row + i];
+					while (word != 0)
+					{
+						const int bit = std::countr_zero(word);
+						func(utils::coords{ static_cast<int>(i) * BITS_PER_WORD + bit, y });
+						word &= word - 1;
+					}
+				}
+			}
+		}
+	};
+
+	inline bit_grid operator&(bit_grid left, const bit_grid& right) { left &= right; return left; }
+	inline bit_grid operator|(bit_grid left, const bit_grid& right) { left |= right; return left; }
+	inline bit_grid operator^(bit_grid left, const bit_grid& right) { left ^= right; return left; }
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+
+#include "../advent/advent_assert.h"
+
+namespace utils
+{
+	// A min-priority queue for small non-negative integer keys that never go below the last key popped,
+	// such as the costs in Dijkstra's algorithm with integer edge weights. There is one bucket per key,
+	// so push is O(1) and popping everything costs O(number of entries + largest key).
+	template <typename ValueType>
+	class bucket_queue
+	{
+		std::vector<std::vector<ValueType>> m_buckets;
+		std::size_t m_current = 0;
+		std::size_t m_size = 0;
+
+		void advance_to_next_entry()
+		{
+			AdventCheck(!empty());
+			while (m_buckets[m_current].empty())
+			{
+				++m_current;
+			}
+		}
+	public:
+		[[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+		[[nodiscard]] std::size_t size() const noexcept { return m_size; }
+
+		void push(std::size_t key, ValueType value)
+		{
+			AdventCheck(key >= m_current);
+			if (key >= m_buckets.size())
+			{
+				m_buckets.resize(key + 1);
+			}
+			m_buckets[key].push_back(std::move(value));
+			++m_size;
+		}
+
+		std::size_t top_key()
+		{
+			advance_to_next_entry();
+			return m_current;
+		}
+
+		std::pair<std::size_t, ValueType> pop()
+		{
+			advance_to_next_entry();
+			std::vector<ValueType>& bucket = m_buckets[m_current];
+			ValueType result = std::move(bucket.back());
+			bucket.pop_back();
+			--m_size;
+			return std::make_pair(m_current, std::move(result));
+		}
+
+		void clear() noexcept
+		{
+			for (std::vector<ValueType>& bucket : m_buckets)
+			{
+				bucket.clear();
+			}
+			m_current = 0;
+			m_size = 0;
+		}
+	};
+}
\ No newline at end of file
@@ -10,7 +10,7 @@
 #include <mutex>
 
 #include "../advent/advent_assert.h"
-#include "sorted_vector.h"
+#include "flat_hash_set.h"
 #include "range_contains.h"
 #include "erase_remove_if.h"
 #include "shared_lock_guard.h"
@@ -38,9 +38,7 @@ namespace utils::conway_simulation
 			: m_on_cells(init_start,init_end)
 			, m_update_cell{ std::move(update) }
 			, m_gather_neighbours{ std::move(gather) }
-		{
-			m_on_cells.unique();
-		}
+		{}
 
 		[[nodiscard]] bool is_cell_on(const CoordType& cell) const noexcept { return m_on_cells.contains(cell); }
 		[[nodiscard]] std::size_t number_of_cells_on() const { return m_on_cells.size(); }
@@ -49,20 +47,19 @@ namespace utils::conway_simulation
 		template <typename ItType>
 		void set_state(ItType first, ItType last)
 		{
-			m_on_cells = sorted_vector<CoordType>(first, last);
-			m_on_cells.unique();
+			m_on_cells = flat_hash_set<CoordType>(first, last);
 		}
 	private:
 		// Primary state
-		sorted_vector<CoordType> m_on_cells;
+		flat_hash_set<CoordType> m_on_cells;
 		UpdateCellFunc m_update_cell;
 		GatherNeighboursFunc m_gather_neighbours;
 
 		// Spare stuff for optimisation
 		mutable std::map<CoordType, std::vector<CoordType>> m_cached_neighbours;
 		mutable std::shared_mutex m_cached_neighbours_lock;
-		sorted_vector<CoordType> m_next_cells;
-		sorted_vector<CoordType> m_relevant_cells;
+		flat_hash_set<CoordType> m_next_cells;
+		flat_hash_set<CoordType> m_relevant_cells;
 
 		// Private functions
 
@@ -204,8 +201,6 @@ namespace utils::conway_simulation
 		};
 		std::for_each(std::execution::unseq, begin(m_on_cells), end(m_on_cells), gather_relevant);
 
-		m_relevant_cells.unique();
-
 		std::copy_if(begin(m_relevant_cells), end(m_relevant_cells), std::back_inserter(m_next_cells),
 			[this](const CoordType& cell)
 		{
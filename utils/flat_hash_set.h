@@ -0,0 +1,615 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <functional>
+#include <array>
+#include <iterator>
+#include <bit>
+#include <type_traits>
+#include <stdexcept>
+#include <algorithm>
+
+#include "../advent/advent_assert.h"
+#include "coords.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AOC_FLAT_HASH_SSE2 1
+#include <emmintrin.h>
+#else
+#define AOC_FLAT_HASH_SSE2 0
+#endif
+
+namespace utils
+{
+	namespace flat_hash_internal
+	{
+		// The low 7 bits of a hash are stored per slot, so every bit of the hash needs to be well mixed.
+		inline constexpr std::uint64_t mix(std::uint64_t x) noexcept
+		{
+			x ^= x >> 33;
+			x *= 0xff51afd7ed558ccdull;
+			x ^= x >> 33;
+			x *= 0xc4ceb9fe1a85ec53ull;
+			x ^= x >> 33;
+			return x;
+		}
+	}
+
+	// Default hash for utils::flat_hash_set and utils::flat_hash_map.
+	template <typename T>
+	struct flat_hash
+	{
+		std::size_t operator()(const T& value) const noexcept
+		{
+			if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+			{
+				return static_cast<std::size_t>(flat_hash_internal::mix(static_cast<std::uint64_t>(value)));
+			}
+			else
+			{
+				return static_cast<std::size_t>(flat_hash_internal::mix(static_cast<std::uint64_t>(std::hash<T>{}(value))));
+			}
+		}
+	};
+
+	// Both coordinates go into one word, so nearby points don't collide the way x ^ y would.
+	template <typename T>
+	struct flat_hash<utils::basic_coords<T>>
+	{
+		std::size_t operator()(const utils::basic_coords<T>& c) const noexcept
+		{
+			const std::uint64_t x = static_cast<std::uint32_t>(c.x);
+			const std::uint64_t y = static_cast<std::uint32_t>(c.y);
+			return static_cast<std::size_t>(flat_hash_internal::mix((x << 32) | y));
+		}
+	};
+
+	template <typename T, std::size_t N>
+	struct flat_hash<std::array<T, N>>
+	{
+		std::size_t operator()(const std::array<T, N>& values) const noexcept
+		{
+			std::uint64_t result = N;
+			for (const T& v : values)
+			{
+				result = flat_hash_internal::mix(result ^ static_cast<std::uint64_t>(flat_hash<T>{}(v)));
+			}
+			return static_cast<std::size_t>(result);
+		}
+	};
+
+	namespace flat_hash_internal
+	{
+		using control_byte = std::int8_t;
+		constexpr control_byte EMPTY = static_cast<control_byte>(-128);
+		constexpr std::size_t GROUP_WIDTH = 16;
+		constexpr std::size_t MIN_CAPACITY = GROUP_WIDTH;
+
+		// Bit i of a match mask is set if the i'th control byte in the group matched.
+		inline std::uint32_t match_byte(const control_byte* group, control_byte value) noexcept
+		{
+#if AOC_FLAT_HASH_SSE2
+			const __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+			return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(value))));
+#else
+			std::uint32_t result = 0;
+			for (std::size_t i = 0; i < GROUP_WIDTH; ++i)
+			{
+				result |= static_cast<std::uint32_t>(group[i] == value) << i;
+			}
+			return result;
+#endif
+		}
+
+		// Open addressing with linear probing, examining 16 control bytes at a time.
+		// Each slot's control byte is EMPTY or the low 7 bits of its hash. The control array has a copy
+		// of its first GROUP_WIDTH bytes on the end so a group can be read from any slot without wrapping.
+		// Erasing shifts later entries back into the gap instead of leaving a tombstone, so lookups never
+		// have to skip over deleted slots. Keys and values must not throw when moved.
+		template <typename ValueType, typename KeyType, typename GetKey, typename Hash, typename KeyEqual>
+		class table
+		{
+			union slot
+			{
+				slot() noexcept {}
+				~slot() {}
+				ValueType value;
+			};
+
+			std::unique_ptr<control_byte[]> m_control;
+			std::unique_ptr<slot[]> m_slots;
+			std::size_t m_capacity = 0;
+			std::size_t m_size = 0;
+			[[no_unique_address]] Hash m_hash;
+			[[no_unique_address]] KeyEqual m_equal;
+
+			std::size_t mask() const noexcept { return m_capacity - 1; }
+			static const KeyType& key_of(const ValueType& value) noexcept { return GetKey{}(value); }
+			static control_byte get_h2(std::size_t hash) noexcept { return static_cast<control_byte>(hash & 0x7F); }
+			std::size_t get_home(std::size_t hash) const noexcept { return (hash >> 7) & mask(); }
+
+			void set_control(std::size_t idx, control_byte value) noexcept
+			{
+				m_control[idx] = value;
+				if (idx < GROUP_WIDTH)
+				{
+					m_control[m_capacity + idx] = value;
+				}
+			}
+
+			void allocate(std::size_t capacity)
+			{
+				m_capacity = capacity;
+				m_control = std::make_unique<control_byte[]>(capacity + GROUP_WIDTH);
+				std::memset(m_control.get(), static_cast<unsigned char>(EMPTY), capacity + GROUP_WIDTH);
+				m_slots = std::make_unique<slot[]>(capacity);
+			}
+
+			void destroy_all() noexcept
+			{
+				if constexpr (!std::is_trivially_destructible_v<ValueType>)
+				{
+					for (std::size_t i = 0; i < m_capacity; ++i)
+					{
+						if (m_control[i] != EMPTY)
+						{
+							m_slots[i].value.~ValueType();
+						}
+					}
+				}
+			}
+
+			// Where a key is, or m_capacity if it isn't here.
+			std::size_t find_index(const KeyType& key, std::size_t hash) const
+			{
+				if (m_capacity == 0) return m_capacity;
+				const control_byte h2 = get_h2(hash);
+				std::size_t pos = get_home(hash);
+				while (true)
+				{
+					const control_byte* group = m_control.get() + pos;
+					for (std::uint32_t matches = match_byte(group, h2); matches != 0; matches &= matches - 1)
+					{
+						const std::size_t idx = (pos + static_cast<std::size_t>(std::countr_zero(matches))) & mask();
+						if (m_equal(key_of(m_slots[idx].value), key))
+						{
+							return idx;
+						}
+					}
+					if (match_byte(group, EMPTY) != 0)
+					{
+						return m_capacity;
+					}
+					pos = (pos + GROUP_WIDTH) & mask();
+				}
+			}
+
+			// Assumes the key is not already here and there is room.
+			std::size_t find_empty(std::size_t hash) const noexcept
+			{
+				std::size_t pos = get_home(hash);
+				while (true)
+				{
+					const std::uint32_t empties = match_byte(m_control.get() + pos, EMPTY);
+					if (empties != 0)
+					{
+						return (pos + static_cast<std::size_t>(std::countr_zero(empties))) & mask();
+					}
+					pos = (pos + GROUP_WIDTH) & mask();
+				}
+			}
+
+			// Keep the load factor at or below 7/8.
+			bool needs_to_grow(std::size_t new_size) const noexcept
+			{
+				return new_size * 8 > m_capacity * 7;
+			}
+
+			void rehash(std::size_t new_capacity)
+			{
+				AdventCheck(std::has_single_bit(new_capacity));
+				std::unique_ptr<control_byte[]> old_control = std::move(m_control);
+				std::unique_ptr<slot[]> old_slots = std::move(m_slots);
+				const std::size_t old_capacity = m_capacity;
+				allocate(new_capacity);
+				for (std::size_t i = 0; i < old_capacity; ++i)
+				{
+					if (old_control[i] == EMPTY) continue;
+					ValueType& value = old_slots[i].value;
+					const std::size_t hash = m_hash(key_of(value));
+					const std::size_t idx = find_empty(hash);
+					::new (&m_slots[idx].value) ValueType(std::move(value));
+					set_control(idx, get_h2(hash));
+					value.~ValueType();
+				}
+			}
+
+			void grow_for(std::size_t new_size)
+			{
+				if (!needs_to_grow(new_size)) return;
+				std::size_t new_capacity = std::max(MIN_CAPACITY, m_capacity);
+				while (new_size * 8 > new_capacity * 7)
+				{
+					new_capacity *= 2;
+				}
+				rehash(new_capacity);
+			}
+
+			void copy_from(const table& other)
+			{
+				m_hash = other.m_hash;
+				m_equal = other.m_equal;
+				if (other.m_capacity == 0) return;
+				allocate(other.m_capacity);
+				std::memcpy(m_control.get(), other.m_control.get(), m_capacity + GROUP_WIDTH);
+				for (std::size_t i = 0; i < m_capacity; ++i)
+				{
+					if (m_control[i] != EMPTY)
+					{
+						::new (&m_slots[i].value) ValueType(other.m_slots[i].value);
+					}
+				}
+				m_size = other.m_size;
+			}
+		public:
+			template <bool IsConst>
+			class basic_iterator
+			{
+				friend class table;
+				template <bool> friend class basic_iterator;
+				using table_ptr = std::conditional_t<IsConst, const table*, table*>;
+				table_ptr m_table = nullptr;
+				std::size_t m_idx = 0;
+				void skip_empty() noexcept
+				{
+					while (m_idx < m_table->m_capacity && m_table->m_control[m_idx] == EMPTY)
+					{
+						++m_idx;
+					}
+				}
+				basic_iterator(table_ptr t, std::size_t idx) noexcept : m_table{ t }, m_idx{ idx } { skip_empty(); }
+			public:
+				using iterator_category = std::forward_iterator_tag;
+				using value_type = ValueType;
+				using difference_type = std::ptrdiff_t;
+				using pointer = std::conditional_t<IsConst, const ValueType*, ValueType*>;
+				using reference = std::conditional_t<IsConst, const ValueType&, ValueType&>;
+
+				basic_iterator() noexcept = default;
+				operator basic_iterator<true>() const noexcept { return basic_iterator<true>{ m_table, m_idx }; }
+
+				reference operator*() const noexcept { return m_table->m_slots[m_idx].value; }
+				pointer operator->() const noexcept { return &m_table->m_slots[m_idx].value; }
+				basic_iterator& operator++() noexcept { ++m_idx; skip_empty(); return *this; }
+				basic_iterator operator++(int) noexcept { basic_iterator result = *this; ++(*this); return result; }
+				bool operator==(const basic_iterator& other) const noexcept { return m_idx == other.m_idx; }
+			};
+			using iterator = basic_iterator<false>;
+			using const_iterator = basic_iterator<true>;
+
+			table() = default;
+			table(const table& other) { copy_from(other); }
+			table(table&& other) noexcept
+				: m_control{ std::move(other.m_control) }
+				, m_slots{ std::move(other.m_slots) }
+				, m_capacity{ std::exchange(other.m_capacity, 0) }
+				, m_size{ std::exchange(other.m_size, 0) }
+				, m_hash{ std::move(other.m_hash) }
+				, m_equal{ std::move(other.m_equal) }
+			{}
+			table& operator=(const table& other)
+			{
+				if (this != &other)
+				{
+					table copy{ other };
+					swap(copy);
+				}
+				return *this;
+			}
+			table& operator=(table&& other) noexcept
+			{
+				table moved{ std::move(other) };
+				swap(moved);
+				return *this;
+			}
+			~table() { destroy_all(); }
+
+			void swap(table& other) noexcept
+			{
+				using std::swap;
+				swap(m_control, other.m_control);
+				swap(m_slots, other.m_slots);
+				swap(m_capacity, other.m_capacity);
+				swap(m_size, other.m_size);
+				swap(m_hash, other.m_hash);
+				swap(m_equal, other.m_equal);
+			}
+
+			[[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+			[[nodiscard]] std::size_t size() const noexcept { return m_size; }
+			[[nodiscard]] std::size_t capacity() const noexcept { return m_capacity; }
+
+			void reserve(std::size_t num_elements) { grow_for(num_elements); }
+
+			void clear() noexcept
+			{
+				destroy_all();
+				if (m_capacity > 0)
+				{
+					std::memset(m_control.get(), static_cast<unsigned char>(EMPTY), m_capacity + GROUP_WIDTH);
+				}
+				m_size = 0;
+			}
+
+			iterator begin() noexcept { return iterator{ this, 0 }; }
+			iterator end() noexcept { return iterator{ this, m_capacity }; }
+			const_iterator begin() const noexcept { return const_iterator{ this, 0 }; }
+			const_iterator end() const noexcept { return const_iterator{ this, m_capacity }; }
+
+			iterator find(const KeyType& key) { return iterator{ this, find_index(key, m_hash(key)) }; }
+			const_iterator find(const KeyType& key) const { return const_iterator{ this, find_index(key, m_hash(key)) }; }
+			bool contains(const KeyType& key) const { return find_index(key, m_hash(key)) != m_capacity; }
+			std::size_t count(const KeyType& key) const { return contains(key) ? 1 : 0; }
+
+			// MakeValue is only called if the key isn't already here.
+			template <typename MakeValue>
+			std::pair<iterator, bool> try_emplace_with(const KeyType& key, const MakeValue& make_value)
+			{
+				const std::size_t hash = m_hash(key);
+				const std::size_t existing = find_index(key, hash);
+				if (existing != m_capacity)
+				{
+					return std::pair{ iterator{ this, existing }, false };
+				}
+				grow_for(m_size + 1);
+				const std::size_t idx = find_empty(hash);
+				::new (&m_slots[idx].value) ValueType(make_value());
+				set_control(idx, get_h2(hash));
+				++m_size;
+				return std::pair{ iterator{ this, idx }, true };
+			}
+
+			void erase(const_iterator pos) noexcept
+			{
+				AdventCheck(pos.m_table == this);
+				AdventCheck(pos.m_idx < m_capacity && m_control[pos.m_idx] != EMPTY);
+				std::size_t gap = pos.m_idx;
+				m_slots[gap].value.~ValueType();
+				for (std::size_t next = (gap + 1) & mask(); m_control[next] != EMPTY; next = (next + 1) & mask())
+				{
+					// An entry can fill the gap if the gap is no further from its home than where it is now.
+					const std::size_t home = get_home(m_hash(key_of(m_slots[next].value)));
+					if (((gap - home) & mask()) > ((next - home) & mask())) continue;
+					::new (&m_slots[gap].value) ValueType(std::move(m_slots[next].value));
+					m_slots[next].value.~ValueType();
+					set_control(gap, m_control[next]);
+					gap = next;
+				}
+				set_control(gap, EMPTY);
+				--m_size;
+			}
+
+			std::size_t erase(const KeyType& key)
+			{
+				const std::size_t idx = find_index(key, m_hash(key));
+				if (idx == m_capacity) return 0;
+				erase(const_iterator{ this, idx });
+				return 1;
+			}
+
+			template <typename Pred>
+			std::size_t erase_if(const Pred& predicate)
+			{
+				const std::size_t old_size = m_size;
+				for (std::size_t i = 0; i < m_capacity;)
+				{
+					if (m_control[i] != EMPTY && predicate(std::as_const(m_slots[i].value)))
+					{
+						const std::size_t capacity_before = m_capacity;
+						erase(const_iterator{ this, i });
+						AdventCheck(capacity_before == m_capacity);
+						// Something may have been shifted into slot i, so look again.
+						// If it came from before slot i (wrapping around), it has already been checked and is kept,
+						// which is fine: at worst it is checked twice.
+						continue;
+					}
+					++i;
+				}
+				return old_size - m_size;
+			}
+		};
+
+		template <typename T>
+		struct identity_key
+		{
+			const T& operator()(const T& value) const noexcept { return value; }
+		};
+
+		template <typename KeyType, typename MappedType>
+		struct pair_first_key
+		{
+			const KeyType& operator()(const std::pair<KeyType, MappedType>& value) const noexcept { return value.first; }
+		};
+	}
+
+	// An unordered set stored in one flat array. See flat_hash_internal::table for how it works.
+	// It has the same member names as utils::sorted_vector where they make sense,
+	// so it can stand in for one that is only being used as a set.
+	template <typename T, typename Hash = utils::flat_hash<T>, typename KeyEqual = std::equal_to<T>>
+	class flat_hash_set
+	{
+		using table_type = flat_hash_internal::table<T, T, flat_hash_internal::identity_key<T>, Hash, KeyEqual>;
+		table_type m_table;
+	public:
+		using value_type = T;
+		using iterator = typename table_type::const_iterator;
+		using const_iterator = typename table_type::const_iterator;
+
+		flat_hash_set() = default;
+		template <typename InputIt>
+		flat_hash_set(InputIt first, InputIt last) { insert(first, last); }
+		flat_hash_set(std::initializer_list<T> ilist) : flat_hash_set(ilist.begin(), ilist.end()) {}
+
+		[[nodiscard]] bool empty() const noexcept { return m_table.empty(); }
+		[[nodiscard]] std::size_t size() const noexcept { return m_table.size(); }
+		[[nodiscard]] std::size_t capacity() const noexcept { return m_table.capacity(); }
+		void reserve(std::size_t num_elements) { m_table.reserve(num_elements); }
+		void clear() noexcept { m_table.clear(); }
+		void swap(flat_hash_set& other) noexcept { m_table.swap(other.m_table); }
+
+		const_iterator begin() const noexcept { return m_table.begin(); }
+		const_iterator end() const noexcept { return m_table.end(); }
+		const_iterator cbegin() const noexcept { return m_table.begin(); }
+		const_iterator cend() const noexcept { return m_table.end(); }
+
+		const_iterator find(const T& value) const { return m_table.find(value); }
+		bool contains(const T& value) const { return m_table.contains(value); }
+		std::size_t count(const T& value) const { return m_table.count(value); }
+
+		std::pair<iterator, bool> insert(const T& value)
+		{
+			return m_table.try_emplace_with(value, [&value]() -> const T& { return value; });
+		}
+
+		std::pair<iterator, bool> insert(T&& value)
+		{
+			return m_table.try_emplace_with(value, [&value]() -> T&& { return std::move(value); });
+		}
+
+		template <typename InputIt>
+		void insert(InputIt first, InputIt last)
+		{
+			if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>)
+			{
+				reserve(size() + static_cast<std::size_t>(std::distance(first, last)));
+			}
+			for (; first != last; ++first)
+			{
+				insert(*first);
+			}
+		}
+
+		std::pair<iterator, bool> insert_unique(const T& value) { return insert(value); }
+		std::pair<iterator, bool> insert_unique(T&& value) { return insert(std::move(value)); }
+
+		// For std::back_inserter compatibility
+		void push_back(const T& value) { insert(value); }
+		void push_back(T&& value) { insert(std::move(value)); }
+
+		// Elements are always unique. This is here so code written for sorted_vector keeps working.
+		void unique() noexcept {}
+
+		void erase(const_iterator pos) { m_table.erase(pos); }
+		std::size_t erase(const T& value) { return m_table.erase(value); }
+		template <typename Pred>
+		std::size_t erase_if(const Pred& predicate) { return m_table.erase_if(predicate); }
+
+		bool operator==(const flat_hash_set& other) const
+		{
+			return size() == other.size() && std::all_of(begin(), end(), [&other](const T& v) { return other.contains(v); });
+		}
+	};
+
+	// An unordered map stored in one flat array, with the same member names as utils::flat_map.
+	template <typename KeyType, typename MappedType, typename Hash = utils::flat_hash<KeyType>, typename KeyEqual = std::equal_to<KeyType>>
+	class flat_hash_map
+	{
+		using table_type = flat_hash_internal::table<std::pair<KeyType, MappedType>, KeyType, flat_hash_internal::pair_first_key<KeyType, MappedType>, Hash, KeyEqual>;
+		table_type m_table;
+	public:
+		using key_type = KeyType;
+		using mapped_type = MappedType;
+		using value_type = std::pair<KeyType, MappedType>;
+		using iterator = typename table_type::iterator;
+		using const_iterator = typename table_type::const_iterator;
+
+		flat_hash_map() = default;
+		template <typename InputIt>
+		flat_hash_map(InputIt first, InputIt last)
+		{
+			for (; first != last; ++first)
+			{
+				insert_unique(first->first, first->second);
+			}
+		}
+
+		[[nodiscard]] bool empty() const noexcept { return m_table.empty(); }
+		[[nodiscard]] std::size_t size() const noexcept { return m_table.size(); }
+		[[nodiscard]] std::size_t capacity() const noexcept { return m_table.capacity(); }
+		void reserve(std::size_t num_elements) { m_table.reserve(num_elements); }
+		void clear() noexcept { m_table.clear(); }
+		void swap(flat_hash_map& other) noexcept { m_table.swap(other.m_table); }
+
+		iterator begin() noexcept { return m_table.begin(); }
+		iterator end() noexcept { return m_table.end(); }
+		const_iterator begin() const noexcept { return m_table.begin(); }
+		const_iterator end() const noexcept { return m_table.end(); }
+		const_iterator cbegin() const noexcept { return m_table.begin(); }
+		const_iterator cend() const noexcept { return m_table.end(); }
+
+		iterator find_by_key(const KeyType& key) { return m_table.find(key); }
+		const_iterator find_by_key(const KeyType& key) const { return m_table.find(key); }
+		iterator find(const KeyType& key) { return m_table.find(key); }
+		const_iterator find(const KeyType& key) const { return m_table.find(key); }
+		bool contains_key(const KeyType& key) const { return m_table.contains(key); }
+		bool contains(const KeyType& key) const { return m_table.contains(key); }
+
+		template <typename K, typename M>
+		std::pair<iterator, bool> insert_unique(K&& key, M&& value)
+		{
+			const KeyType& key_ref = key;
+			return m_table.try_emplace_with(key_ref, [&key, &value]()
+				{
+					return value_type{ std::forward<K>(key), std::forward<M>(value) };
+				});
+		}
+
+		std::pair<iterator, bool> insert(const value_type& value) { return insert_unique(value.first, value.second); }
+		std::pair<iterator, bool> insert(value_type&& value) { return insert_unique(std::move(value.first), std::move(value.second)); }
+
+		template <typename K, typename M>
+		std::pair<iterator, bool> insert_or_assign(K&& key, M&& value)
+		{
+			const iterator find_result = find_by_key(key);
+			if (find_result != end())
+			{
+				find_result->second = std::forward<M>(value);
+				return std::pair{ find_result, false };
+			}
+			return insert_unique(std::forward<K>(key), std::forward<M>(value));
+		}
+
+		MappedType& operator[](const KeyType& key)
+		{
+			return m_table.try_emplace_with(key, [&key]() { return value_type{ key, MappedType{} }; }).first->second;
+		}
+
+		MappedType& at(const KeyType& key)
+		{
+			const iterator result = find_by_key(key);
+			if (result == end())
+			{
+				throw std::out_of_range{ "Tried to access an element in a utils::flat_hash_map that does not exist." };
+			}
+			return result->second;
+		}
+
+		const MappedType& at(const KeyType& key) const
+		{
+			const const_iterator result = find_by_key(key);
+			if (result == end())
+			{
+				throw std::out_of_range{ "Tried to access an element in a utils::flat_hash_map that does not exist." };
+			}
+			return result->second;
+		}
+
+		void erase(const_iterator pos) { m_table.erase(pos); }
+		std::size_t erase(const KeyType& key) { return m_table.erase(key); }
+		template <typename Pred>
+		std::size_t erase_if(const Pred& predicate) { return m_table.erase_if(predicate); }
+	};
+}
\ No newline at end of file
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <vector>
+#include <span>
+#include <bit>
+#include <functional>
+#include <stdexcept>
+#include <algorithm>
+#include <type_traits>
+#include <new>
+#include <cstddef>
+
+#include "../advent/advent_assert.h"
+#include "sorted_vector.h"
+
+#if !(defined(__GNUC__) || defined(__clang__)) && (defined(_M_X64) || defined(_M_IX86))
+#define AOC_FROZEN_MAP_MM_PREFETCH 1
+#include <xmmintrin.h>
+#else
+#define AOC_FROZEN_MAP_MM_PREFETCH 0
+#endif
+
+namespace utils
+{
+	namespace frozen_flat_map_internal
+	{
+		inline void prefetch([[maybe_unused]] const void* address) noexcept
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			__builtin_prefetch(address);
+#elif AOC_FROZEN_MAP_MM_PREFETCH
+			_mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#endif
+		}
+
+		inline constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+		// Puts the keys at the start of a cache line, so the tree levels that fit in one line do not straddle two.
+		template <typename T>
+		struct cache_line_allocator
+		{
+			using value_type = T;
+
+			cache_line_allocator() = default;
+			template <typename U>
+			cache_line_allocator(const cache_line_allocator<U>&) noexcept {}
+
+			T* allocate(std::size_t n)
+			{
+				return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ CACHE_LINE_SIZE }));
+			}
+
+			void deallocate(T* ptr, std::size_t n) noexcept
+			{
+				::operator delete(ptr, n * sizeof(T), std::align_val_t{ CACHE_LINE_SIZE });
+			}
+
+			template <typename U>
+			bool operator==(const cache_line_allocator<U>&) const noexcept { return true; }
+		};
+	}
+
+	// A read-only copy of a flat_map, for maps that are built once and then looked up a lot.
+	// The keys are stored in Eytzinger order: the root of a binary search tree, then its two children,
+	// then their four children and so on. The top levels of the tree share a few cache lines that stay hot,
+	// each step down picks the child with arithmetic rather than a branch, and the keys a few levels further
+	// down are prefetched while the current one is compared. Values are kept apart from the keys so the
+	// search only touches keys.
+	//     const utils::frozen_flat_map lookup{ std::move(my_flat_map) };
+	template <typename KeyType, typename MappedType, typename KeyCompare = std::less<KeyType>>
+	class frozen_flat_map
+	{
+		// Tree node n (counting from 1, so the children of n are 2n and 2n+1) has its key at m_keys[n], after an
+		// unused first key, and its value at m_values[n-1].
+		std::vector<KeyType, frozen_flat_map_internal::cache_line_allocator<KeyType>> m_keys;
+		std::vector<MappedType> m_values;
+
+		// How many keys fit in a cache line. The descendants of node n log2(PREFETCH_STRIDE) levels down are the
+		// PREFETCH_STRIDE keys from n * PREFETCH_STRIDE on, which is one whole cache line when sizeof(KeyType)
+		// divides the line size, so a prefetch there fetches every key the search could reach at that level.
+		static constexpr std::size_t PREFETCH_STRIDE = std::bit_floor(std::max<std::size_t>(frozen_flat_map_internal::CACHE_LINE_SIZE / sizeof(KeyType), 1));
+
+		// Fills in which element (in sorted order) belongs at each node with an in-order walk of the tree.
+		static void fill_sorted_indices(std::vector<std::size_t>& sorted_indices, std::size_t& next_sorted_idx, std::size_t node)
+		{
+			if (node > sorted_indices.size()) return;
+			fill_sorted_indices(sorted_indices, next_sorted_idx, 2 * node);
+			sorted_indices[node - 1] = next_sorted_idx++;
+			fill_sorted_indices(sorted_indices, next_sorted_idx, 2 * node + 1);
+		}
+
+		template <typename SourceMap>
+		void build(SourceMap&& source)
+		{
+			std::vector<std::size_t> sorted_indices(source.size());
+			std::size_t next_sorted_idx = 0;
+			fill_sorted_indices(sorted_indices, next_sorted_idx, 1);
+			if (sorted_indices.empty()) return;
+			m_keys.reserve(sorted_indices.size() + 1);
+			m_values.reserve(sorted_indices.size());
+			m_keys.emplace_back();
+			const auto sorted_begin = source.begin();
+			for (std::size_t sorted_idx : sorted_indices)
+			{
+				auto& [key, value] = sorted_begin[sorted_idx];
+				if constexpr (std::is_rvalue_reference_v<SourceMap&&>)
+				{
+					m_keys.push_back(std::move(key));
+					m_values.push_back(std::move(value));
+				}
+				else
+				{
+					m_keys.push_back(key);
+					m_values.push_back(value);
+				}
+			}
+		}
+
+		// Position of the first key that is not less than key, or size() if there isn't one.
+		std::size_t lower_bound_index(const KeyType& key) const
+		{
+			const KeyCompare comp{};
+			const KeyType* const keys = m_keys.data();
+			const std::size_t num_keys = size();
+			std::size_t node = 1;
+			while (node <= num_keys)
+			{
+				if constexpr (PREFETCH_STRIDE > 1)
+				{
+					const std::size_t ahead = node * PREFETCH_STRIDE;
+					if (ahead <= num_keys) frozen_flat_map_internal::prefetch(keys + ahead);
+				}
+				node = 2 * node + static_cast<std::size_t>(comp(keys[node], key));
+			}
+
+			// The walk went right every time after the last left turn, which was at the answer. Undo those steps.
+			node >>= std::countr_one(node) + 1;
+			return node == 0 ? num_keys : node - 1;
+		}
+	public:
+		using key_type = KeyType;
+		using mapped_type = MappedType;
+
+		frozen_flat_map() = default;
+
+		template <std::size_t BufferSize, typename Alloc>
+		explicit frozen_flat_map(const flat_map<KeyType, MappedType, KeyCompare, BufferSize, Alloc>& source)
+		{
+			build(source);
+		}
+
+		template <std::size_t BufferSize, typename Alloc>
+		explicit frozen_flat_map(flat_map<KeyType, MappedType, KeyCompare, BufferSize, Alloc>&& source)
+		{
+			build(std::move(source));
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept { return m_values.size(); }
+		[[nodiscard]] bool empty() const noexcept { return m_values.empty(); }
+
+		// nullptr if the key is not there.
+		const MappedType* find_by_key(const KeyType& key) const
+		{
+			const std::size_t idx = lower_bound_index(key);
+			if (idx == size() || KeyCompare{}(key, m_keys[idx + 1])) return nullptr;
+			return &m_values[idx];
+		}
+
+		bool contains_key(const KeyType& key) const
+		{
+			return find_by_key(key) != nullptr;
+		}
+
+		const MappedType& at(const KeyType& key) const
+		{
+			const MappedType* const result = find_by_key(key);
+			if (result == nullptr)
+			{
+				throw std::out_of_range{ "Tried to access an element in a utils::frozen_flat_map that does not exist." };
+			}
+			return *result;
+		}
+
+		// These are in tree order, not sorted order. keys()[i] goes with values()[i].
+		std::span<const KeyType> keys() const noexcept { return empty() ? std::span<const KeyType>{} : std::span<const KeyType>{ m_keys }.subspan(1); }
+		std::span<const MappedType> values() const noexcept { return m_values; }
+	};
+}
+
+#undef AOC_FROZEN_MAP_MM_PREFETCH
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include <optional>
 #include <algorithm>
 #include <concepts>
+#include <limits>
+#include <vector>
 
 #include "../advent/advent_assert.h"
 #include "istream_line_iterator.h"
@@ -13,6 +15,8 @@
 #include "int_range.h"
 #include "small_vector.h"
 #include "range_contains.h"
+#include "radix_heap.h"
+#include "indexed_priority_queue.h"
 
 #define AOC_GRID_DEBUG_DEFAULT 0
 #if NDEBUG
@@ -27,16 +31,21 @@
 
 namespace utils
 {
-	template <typename NodeType>
+	template <typename NodeType, typename ALLOC = std::allocator<NodeType>>
 	class grid
 	{
-		utils::small_vector<NodeType,1> m_nodes;
+		utils::small_vector<NodeType,1,ALLOC> m_nodes;
 		utils::coords m_max_point;
 		std::size_t get_idx(std::integral auto x, std::integral auto y) const;
+		utils::coords get_coords_from_idx(std::size_t idx) const;
 	public:
 		using value_type = NodeType;
 		using reference = NodeType&;
 		using const_reference = const NodeType&;
+		using allocator_type = ALLOC;
+		grid() = default;
+		explicit grid(const allocator_type& alloc) : m_nodes{ alloc } {}
+		allocator_type get_allocator() const noexcept { return m_nodes.get_allocator(); }
 		auto operator==(const grid& other) const noexcept requires std::equality_comparable<NodeType>
 		{
 			return m_max_point == other.m_max_point && stdr::equal(m_nodes, other.m_nodes);
@@ -166,6 +175,13 @@ namespace utils
 			const auto& cost_or_heuristic_fn) const;
 
 		utils::small_vector<utils::coords,1> get_path(const utils::coords& start, const utils::coords& end) const;
+
+		// Searches from both ends at once. There is no heuristic, but it only needs to explore
+		// around two circles half the size of the one a plain search would cover.
+		utils::small_vector<utils::coords,1> get_path_bidirectional(const utils::coords& start, const utils::coords& end,
+			const auto& traverse_cost_fn) const;
+
+		utils::small_vector<utils::coords,1> get_path_bidirectional(const utils::coords& start, const utils::coords& end) const;
 	};
 
 	namespace grid_helpers
@@ -199,6 +215,17 @@ namespace utils
 			return result;
 		}
 
+		// As above, with the nodes in memory from alloc.
+		template <typename ALLOC>
+		auto build(std::istream& iss, const auto& char_to_node_fn, const ALLOC& alloc)
+		{
+			using NodeType = decltype(char_to_node_fn(' '));
+			using NodeAlloc = typename std::allocator_traits<ALLOC>::template rebind_alloc<NodeType>;
+			grid<NodeType, NodeAlloc> result{ NodeAlloc{ alloc } };
+			result.build_from_stream(iss, char_to_node_fn);
+			return result;
+		}
+
 		template <typename NodeType>
 		struct DefaultHeuristicFunctor
 		{
@@ -255,19 +282,41 @@ namespace utils
 
 		namespace internal_helpers
 		{
+			// Flat per-cell state for grid<T>::get_path and friends.
+			struct path_search_state
+			{
+				static constexpr std::size_t NO_IDX = std::numeric_limits<std::size_t>::max();
+				std::vector<float> costs;
+				std::vector<std::size_t> previous_idx;
+				std::vector<bool> searched;
+				explicit path_search_state(std::size_t num_cells)
+					: costs(num_cells, std::numeric_limits<float>::infinity())
+					, previous_idx(num_cells, NO_IDX)
+					, searched(num_cells, false)
+				{}
+			};
+
+			// Plain Dijkstra never pops a key lower than the last one, so it can use a radix_heap.
+			// A* keys (cost + heuristic) can go down, so get_path uses an indexed_priority_queue instead.
+			struct dijkstra_search_state : path_search_state
+			{
+				utils::radix_heap<float, std::size_t> unsearched_nodes;
+				using path_search_state::path_search_state;
+			};
+
 			template <grid_type T>
 			struct node_ref_type {};
 
-			template <typename T>
-			struct node_ref_type<const grid<T>>
+			template <typename T, typename ALLOC>
+			struct node_ref_type<const grid<T, ALLOC>>
 			{
-				using type = typename grid<T>::const_reference;
+				using type = typename grid<T, ALLOC>::const_reference;
 			};
 
-			template <typename T>
-			struct node_ref_type<grid<T>>
+			template <typename T, typename ALLOC>
+			struct node_ref_type<grid<T, ALLOC>>
 			{
-				using type = typename grid<T>::reference;
+				using type = typename grid<T, ALLOC>::reference;
 			};
 
 			template <grid_type T>
@@ -456,16 +505,16 @@ namespace utils
 		};
 	}
 
-	template <typename NodeType>
-	inline std::ostream& operator<<(std::ostream& oss, const utils::grid<NodeType>& grid)
+	template <typename NodeType, typename ALLOC>
+	inline std::ostream& operator<<(std::ostream& oss, const utils::grid<NodeType, ALLOC>& grid)
 	{
 		grid.stream_grid(oss);
 		return oss;
 	}
 }
 
-template <typename NodeType>
-inline bool utils::grid<NodeType>::is_on_grid(std::integral auto x, std::integral auto y) const
+template <typename NodeType, typename ALLOC>
+inline bool utils::grid<NodeType, ALLOC>::is_on_grid(std::integral auto x, std::integral auto y) const
 {
 	if(x < 0) return false;
 	if(y < 0) return false;
@@ -474,8 +523,8 @@ inline bool utils::grid<NodeType>::is_on_grid(std::integral auto x, std::integra
 	return true;
 }
 
-template <typename NodeType>
-inline std::size_t utils::grid<NodeType>::get_idx(std::integral auto x, std::integral auto y) const
+template <typename NodeType, typename ALLOC>
+inline std::size_t utils::grid<NodeType, ALLOC>::get_idx(std::integral auto x, std::integral auto y) const
 {
 	AdventCheck(is_on_grid(x,y));
 	const auto inverted_y = m_max_point.y - y - 1;
@@ -483,8 +532,17 @@ inline std::size_t utils::grid<NodeType>::get_idx(std::integral auto x, std::int
 	return result;
 }
 
-template<typename NodeType>
-inline utils::small_vector<utils::coords,1> utils::grid<NodeType>::get_path(const utils::coords& start, const auto& is_end_fn, const auto& traverse_cost_fn, const auto& heuristic_fn) const
+template <typename NodeType, typename ALLOC>
+inline utils::coords utils::grid<NodeType, ALLOC>::get_coords_from_idx(std::size_t idx) const
+{
+	AdventCheck(idx < m_nodes.size());
+	const int x = static_cast<int>(idx % m_max_point.x);
+	const int inverted_y = static_cast<int>(idx / m_max_point.x);
+	return utils::coords{ x, m_max_point.y - inverted_y - 1 };
+}
+
+template <typename NodeType, typename ALLOC>
+inline utils::small_vector<utils::coords,1> utils::grid<NodeType, ALLOC>::get_path(const utils::coords& start, const auto& is_end_fn, const auto& traverse_cost_fn, const auto& heuristic_fn) const
 {
 	AdventCheck(is_on_grid(start));
 	constexpr bool check_end_fn = utils::grid_helpers::is_end_fn<NodeType,decltype(is_end_fn)>();
@@ -496,153 +554,182 @@ inline utils::small_vector<utils::coords,1> utils::grid<NodeType>::get_path(cons
 
 	utils::small_vector<utils::coords,1> result;
 
-	struct SearchNode
-	{
-		int previous_node_id = -1;
-		utils::coords position;
-		float cost = 0.0f;
-		float cost_and_heuristic = 0.0f;
-	};
-
-	auto order_on_heuristic = [](const SearchNode& left, const SearchNode& right)
-	{
-		return left.cost_and_heuristic > right.cost_and_heuristic;
-	};
+	// Search state is kept per cell and indexed with get_idx. The queue holds each cell once,
+	// and its key is lowered when the cell is reached more cheaply.
+	grid_helpers::internal_helpers::path_search_state search{ size() };
+	utils::indexed_priority_queue<float> unsearched_nodes{ size() };
 
-	utils::small_vector<SearchNode,1> searched_nodes;
-	utils::small_vector<SearchNode,1> unsearched_nodes;
+	const std::size_t start_idx = get_idx(start.x, start.y);
+	search.costs[start_idx] = 0.0f;
+	unsearched_nodes.push(start_idx, heuristic_fn(start, at(start)));
 
-	auto try_add_node = [this,&unsearched_nodes,&searched_nodes, &traverse_cost_fn, &heuristic_fn]
-		(int previous_node_id, const SearchNode& from, utils::coords to)
+	while (!unsearched_nodes.empty())
 	{
-		if (!is_on_grid(to))
+		const std::size_t current_idx = unsearched_nodes.pop();
+		if (search.searched[current_idx])
 		{
-#if AOC_GRID_DEBUG
-			std::cout << "    Skip adding node at " << to << ": Not on grid.\n";
-#endif
-			return;
+			continue;
 		}
-		const auto has_checked_result = std::find_if(begin(searched_nodes), end(searched_nodes), [this,&to](const SearchNode& node)
-			{
-				return node.position == to;
-			});
-		if (has_checked_result != end(searched_nodes))
-		{
+		search.searched[current_idx] = true;
+
+		const utils::coords current_pos = get_coords_from_idx(current_idx);
+		const NodeType& current_node = m_nodes[current_idx];
 #if AOC_GRID_DEBUG
-			std::cout << "    Skip adding node at " << to << ": Already checked.\n";
+		std::cout << "Expanding node: " << current_pos << " with cost=" << search.costs[current_idx] << '\n';
 #endif
-			return;
-		}
-		SearchNode result;
-		result.previous_node_id = previous_node_id;
-		result.position = to;
 
-		const NodeType& to_node(at(to));
-		if (previous_node_id >= 0)
+		if (is_end_fn(current_pos, current_node))
 		{
-			const NodeType& from_node = at(from.position);
-			const std::optional<float> latest_cost_opt = traverse_cost_fn(from.position, from_node, to, to_node);
-			if (!latest_cost_opt.has_value())
+			for (std::size_t idx = current_idx; idx != search.NO_IDX; idx = search.previous_idx[idx])
 			{
+				result.push_back(get_coords_from_idx(idx));
+			}
 #if AOC_GRID_DEBUG
-				std::cout << "    Skip adding node at " << to << ": Cannot traverse.\n";
+			std::cout << "Found target node: " << current_pos << " Total path len=" << result.size() << '\n';
 #endif
-				return;
-			}
-			const float latest_cost = *latest_cost_opt;
-			result.cost = from.cost + latest_cost;
+			break;
 		}
-		else
+
+		for (int dx : utils::int_range{ -1,2 })
 		{
-			result.cost = 0.0f;
+			for (int dy : utils::int_range{ -1,2 })
+			{
+				if (dx == 0 && dy == 0) continue;
+				const utils::coords next_pos = current_pos + utils::coords{ dx,dy };
+				if (!is_on_grid(next_pos)) continue;
+				const std::size_t next_idx = get_idx(next_pos.x, next_pos.y);
+				if (search.searched[next_idx]) continue;
+
+				const NodeType& next_node = m_nodes[next_idx];
+				const std::optional<float> step_cost = traverse_cost_fn(current_pos, current_node, next_pos, next_node);
+				if (!step_cost.has_value()) continue;
+
+				const float next_cost = search.costs[current_idx] + *step_cost;
+				if (!(next_cost < search.costs[next_idx])) continue;
+				search.costs[next_idx] = next_cost;
+				search.previous_idx[next_idx] = current_idx;
+				unsearched_nodes.push_or_decrease(next_idx, next_cost + heuristic_fn(next_pos, next_node));
+			}
 		}
-		const float heuristic = heuristic_fn(to, to_node);
-		result.cost_and_heuristic = result.cost + heuristic;
-#if AOC_GRID_DEBUG
-		std::cout << "    Adding node to search: Loc="
-			<< result.position << " C=" << result.cost << " H=" << result.cost_and_heuristic << '\n';
-#endif
-		unsearched_nodes.push_back(result);
-	};
+	}
+
+	return result;
+}
+
+template <typename NodeType, typename ALLOC>
+inline utils::small_vector<utils::coords,1> utils::grid<NodeType, ALLOC>::get_path_bidirectional(const utils::coords& start, const utils::coords& end, const auto& traverse_cost_fn) const
+{
+	AdventCheck(is_on_grid(start));
+	AdventCheck(is_on_grid(end));
+	constexpr bool check_traverse_fn = utils::grid_helpers::is_cost_fn<NodeType,decltype(traverse_cost_fn)>();
+	static_assert(check_traverse_fn, "traverse_fn must have the signature std::optional<float>(utils::coords,NodeType,utils::coords,NodeType)");
 
+	using grid_helpers::internal_helpers::path_search_state;
+	using grid_helpers::internal_helpers::dijkstra_search_state;
+	utils::small_vector<utils::coords,1> result;
+	if (start == end)
 	{
-		SearchNode first_node;
-		first_node.position = start;
-		try_add_node(-1, SearchNode{}, start);
+		result.push_back(start);
+		return result;
 	}
 
-	while (!unsearched_nodes.empty())
+	dijkstra_search_state forward{ size() };
+	dijkstra_search_state backward{ size() };
+	const std::size_t start_idx = get_idx(start.x, start.y);
+	const std::size_t end_idx = get_idx(end.x, end.y);
+	forward.costs[start_idx] = 0.0f;
+	forward.unsearched_nodes.push(0.0f, start_idx);
+	backward.costs[end_idx] = 0.0f;
+	backward.unsearched_nodes.push(0.0f, end_idx);
+
+	float best_cost = std::numeric_limits<float>::infinity();
+	std::size_t meeting_idx = path_search_state::NO_IDX;
+
+	// The backward search follows edges the wrong way, so it asks for the cost of moving from the neighbour to the current cell.
+	auto expand = [this, &traverse_cost_fn, &best_cost, &meeting_idx](dijkstra_search_state& search, const dijkstra_search_state& other, bool is_forward)
 	{
-#if AOC_GRID_DEBUG
-		std::cout << "Searched nodes: " << searched_nodes.size() << " Unsearched nodes: " << unsearched_nodes.size() << '\n';
-#endif
-		const SearchNode next_node = unsearched_nodes.back();
-#if AOC_GRID_DEBUG
-		std::cout << "Expanding node: " << next_node.position << " with cost=" << next_node.cost
-			<< " heuristic=" << next_node.cost_and_heuristic << '\n';
-#endif
-		unsearched_nodes.pop_back();
+		const std::size_t current_idx = search.unsearched_nodes.pop().second;
+		if (search.searched[current_idx]) return;
+		search.searched[current_idx] = true;
 
+		const utils::coords current_pos = get_coords_from_idx(current_idx);
+		const NodeType& current_node = m_nodes[current_idx];
+		for (int dx : utils::int_range{ -1,2 })
 		{
-			const auto already_checked_result = std::find_if(begin(searched_nodes), end(searched_nodes),
-				[&next_node](const SearchNode& previous_node)
-				{
-					return next_node.position == previous_node.position;
-				});
-			if (already_checked_result != end(searched_nodes))
+			for (int dy : utils::int_range{ -1,2 })
 			{
-#if AOC_GRID_DEBUG
-				std::cout << "    Skipping node " << next_node.position << ": already searched here.\n";
-#endif
-				continue;
+				if (dx == 0 && dy == 0) continue;
+				const utils::coords next_pos = current_pos + utils::coords{ dx,dy };
+				if (!is_on_grid(next_pos)) continue;
+				const std::size_t next_idx = get_idx(next_pos.x, next_pos.y);
+				if (search.searched[next_idx]) continue;
+
+				const NodeType& next_node = m_nodes[next_idx];
+				const std::optional<float> step_cost = is_forward
+					? traverse_cost_fn(current_pos, current_node, next_pos, next_node)
+					: traverse_cost_fn(next_pos, next_node, current_pos, current_node);
+				if (!step_cost.has_value()) continue;
+
+				const float next_cost = search.costs[current_idx] + *step_cost;
+				if (!(next_cost < search.costs[next_idx])) continue;
+				search.costs[next_idx] = next_cost;
+				search.previous_idx[next_idx] = current_idx;
+				search.unsearched_nodes.push(next_cost, next_idx);
+
+				const float through_cost = next_cost + other.costs[next_idx];
+				if (through_cost < best_cost)
+				{
+					best_cost = through_cost;
+					meeting_idx = next_idx;
+				}
 			}
 		}
+	};
 
-		const bool node_is_end = is_end_fn(next_node.position,at(next_node.position));
-		if (node_is_end)
+	while (!forward.unsearched_nodes.empty() && !backward.unsearched_nodes.empty())
+	{
+		const float forward_min = forward.unsearched_nodes.top_key();
+		const float backward_min = backward.unsearched_nodes.top_key();
+		if (forward_min + backward_min >= best_cost)
 		{
-			SearchNode path_node = next_node;
-			while(true)
-			{
-				result.push_back(path_node.position);
-				if (path_node.previous_node_id < 0)
-				{
-					break;
-				}
-				else
-				{
-					const std::size_t previous_idx = static_cast<std::size_t>(path_node.previous_node_id);
-					AdventCheck(previous_idx < searched_nodes.size());
-					path_node = searched_nodes[previous_idx];
-				}
-			}
-#if AOC_GRID_DEBUG
-			std::cout << "Found target node: " << next_node.position << " Total path len=" << result.size() << '\n';
-#endif
 			break;
 		}
-
-		const int previous_id = static_cast<int>(searched_nodes.size());
-		for (int dx : utils::int_range{ -1,2 })
+		if (forward.unsearched_nodes.size() <= backward.unsearched_nodes.size())
 		{
-			for (int dy : utils::int_range{ -1,2 })
-			{
-				if (dx == 0 && dy == 0) continue;
-				const utils::coords delta_pos{ dx,dy };
-				const utils::coords next_coords = next_node.position + delta_pos;
-				try_add_node(previous_id, next_node, next_coords);
-			}
+			expand(forward, backward, true);
 		}
+		else
+		{
+			expand(backward, forward, false);
+		}
+	}
 
-		std::sort(begin(unsearched_nodes), end(unsearched_nodes), order_on_heuristic);
-		searched_nodes.push_back(next_node);
+	if (meeting_idx == path_search_state::NO_IDX)
+	{
+		return result;
 	}
 
+	// Same order as get_path: end first.
+	for (std::size_t idx = backward.previous_idx[meeting_idx]; idx != path_search_state::NO_IDX; idx = backward.previous_idx[idx])
+	{
+		result.push_back(get_coords_from_idx(idx));
+	}
+	stdr::reverse(result);
+	for (std::size_t idx = meeting_idx; idx != path_search_state::NO_IDX; idx = forward.previous_idx[idx])
+	{
+		result.push_back(get_coords_from_idx(idx));
+	}
 	return result;
 }
 
-template<typename NodeType>
-inline utils::small_vector<utils::coords,1> utils::grid<NodeType>::get_path(const utils::coords& start, const auto& is_end_fn, const auto& cost_or_heuristic_fn) const
+template <typename NodeType, typename ALLOC>
+inline utils::small_vector<utils::coords,1> utils::grid<NodeType, ALLOC>::get_path_bidirectional(const utils::coords& start, const utils::coords& end) const
+{
+	return get_path_bidirectional(start, end, utils::grid_helpers::DefaultCostFunctor<NodeType,false>{});
+}
+
+template <typename NodeType, typename ALLOC>
+inline utils::small_vector<utils::coords,1> utils::grid<NodeType, ALLOC>::get_path(const utils::coords& start, const auto& is_end_fn, const auto& cost_or_heuristic_fn) const
 {
 	constexpr bool is_cost_fn = utils::grid_helpers::is_cost_fn<NodeType,decltype(cost_or_heuristic_fn)>();
 	constexpr bool is_heuristic_fn = utils::grid_helpers::is_heuristic_fn<NodeType, decltype(cost_or_heuristic_fn)>();
@@ -654,21 +741,21 @@ inline utils::small_vector<utils::coords,1> utils::grid<NodeType>::get_path(cons
 	}
 	if constexpr (is_heuristic_fn)
 	{
-		auto cost_fn = utils::grid_helpers::DefaultCostFunctor<false>{};
+		auto cost_fn = utils::grid_helpers::DefaultCostFunctor<NodeType,false>{};
 		return get_path(start, is_end_fn, cost_fn, cost_or_heuristic_fn);
 	}
 	AdventUnreachable();
 	return utils::small_vector<utils::coords,1>{};
 }
 
-template<typename NodeType>
-inline utils::small_vector<utils::coords,1> utils::grid<NodeType>::get_path(const utils::coords& start, const auto& is_end_fn) const
+template <typename NodeType, typename ALLOC>
+inline utils::small_vector<utils::coords,1> utils::grid<NodeType, ALLOC>::get_path(const utils::coords& start, const auto& is_end_fn) const
 {
-	return get_path(start, is_end_fn, utils::grid_helpers::DefaultCostFunctor<false>{}, utils::grid_helpers::DefaultHeuristicFunctor<NodeType>{});
+	return get_path(start, is_end_fn, utils::grid_helpers::DefaultCostFunctor<NodeType,false>{}, utils::grid_helpers::DefaultHeuristicFunctor<NodeType>{});
 }
 
-template<typename NodeType>
-inline utils::small_vector<utils::coords,1> utils::grid<NodeType>::get_path(const utils::coords& start, const utils::coords& end, const auto& traverse_cost_fn, const auto& heuristic_fn) const
+template <typename NodeType, typename ALLOC>
+inline utils::small_vector<utils::coords,1> utils::grid<NodeType, ALLOC>::get_path(const utils::coords& start, const utils::coords& end, const auto& traverse_cost_fn, const auto& heuristic_fn) const
 {
 	auto is_end_fn = [&end](const utils::coords& test, const NodeType& node)
 	{
@@ -677,8 +764,8 @@ inline utils::small_vector<utils::coords,1> utils::grid<NodeType>::get_path(cons
 	return get_path(start, is_end_fn, traverse_cost_fn, heuristic_fn);
 }
 
-template<typename NodeType>
-inline utils::small_vector<utils::coords,1> utils::grid<NodeType>::get_path(const utils::coords& start, const utils::coords& end, const auto& cost_or_heuristic_fn) const
+template <typename NodeType, typename ALLOC>
+inline utils::small_vector<utils::coords,1> utils::grid<NodeType, ALLOC>::get_path(const utils::coords& start, const utils::coords& end, const auto& cost_or_heuristic_fn) const
 {
 	constexpr bool is_cost_fn = utils::grid_helpers::is_cost_fn<NodeType,decltype(cost_or_heuristic_fn)>();
 	constexpr bool is_heuristic_fn = utils::grid_helpers::is_heuristic_fn<NodeType,decltype(cost_or_heuristic_fn)>();
@@ -690,40 +777,40 @@ inline utils::small_vector<utils::coords,1> utils::grid<NodeType>::get_path(cons
 	}
 	if constexpr (is_heuristic_fn)
 	{
-		auto cost_fn = utils::grid_helpers::DefaultCostFunctor<false>{};
+		auto cost_fn = utils::grid_helpers::DefaultCostFunctor<NodeType,false>{};
 		return get_path(start, end, cost_fn, cost_or_heuristic_fn);
 	}
 	AdventUnreachable();
 	return utils::small_vector<utils::coords,1>{};
 }
 
-template<typename NodeType>
-inline utils::small_vector<utils::coords,1> utils::grid<NodeType>::get_path(const utils::coords& start, const utils::coords& end) const
+template <typename NodeType, typename ALLOC>
+inline utils::small_vector<utils::coords,1> utils::grid<NodeType, ALLOC>::get_path(const utils::coords& start, const utils::coords& end) const
 {
-	return get_path(start, end, utils::grid_helpers::DefaultCostFunctor{}, utils::grid_helpers::DefaultHeuristicFunctor<NodeType>{ end });
+	return get_path(start, end, utils::grid_helpers::DefaultCostFunctor<NodeType,false>{}, utils::grid_helpers::DefaultHeuristicFunctor<NodeType>{ end });
 }
 
-template<typename NodeType>
+template <typename NodeType, typename ALLOC>
 template<typename Convert>
-inline void utils::grid<NodeType>::stream_row(std::ostream& oss, int row_idx, const Convert& convert) const
+inline void utils::grid<NodeType, ALLOC>::stream_row(std::ostream& oss, int row_idx, const Convert& convert) const
 {
 	AdventCheck(utils::range_contains_exc(row_idx, 0, m_max_point.y));
 	const auto row_view = grid_helpers::get_row_elem_view(*this, row_idx);
 	grid_helpers::stream_view(oss, row_view, convert);
 }
 
-template<typename NodeType>
+template <typename NodeType, typename ALLOC>
 template<typename Convert>
-inline void utils::grid<NodeType>::stream_column(std::ostream& oss, int column_idx, const Convert& convert) const
+inline void utils::grid<NodeType, ALLOC>::stream_column(std::ostream& oss, int column_idx, const Convert& convert) const
 {
 	AdventCheck(utils::range_contains_exc(column_idx, 0, m_max_point.x));
 	const auto column_view = grid_helpers::get_column_elem_view(*this, column_idx);
 	grid_helpers::stream_view(oss, column_view, convert);
 }
 
-template<typename NodeType>
+template <typename NodeType, typename ALLOC>
 template<typename Convert>
-inline void utils::grid<NodeType>::stream_grid(std::ostream& oss, const Convert& convert) const
+inline void utils::grid<NodeType, ALLOC>::stream_grid(std::ostream& oss, const Convert& convert) const
 {
 	for (int row_idx : utils::int_range{ m_max_point.y }.reverse())
 	{
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <algorithm>
+
+#include "../advent/advent_assert.h"
+
+namespace utils
+{
+	// A binary heap of integer handles, each with a key, that can find any handle in O(1)
+	// and so supports decrease_key. top() is the handle with the smallest key under Compare.
+	// Handles should be small and dense (e.g. 0..N-1), as storage is indexed by them.
+	template <typename KeyType, typename Compare = std::less<KeyType>>
+	class indexed_priority_queue
+	{
+	public:
+		static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+	private:
+		std::vector<std::size_t> m_heap;
+		std::vector<std::size_t> m_positions;
+		std::vector<KeyType> m_keys;
+		Compare m_compare;
+
+		bool is_before(std::size_t heap_idx_a, std::size_t heap_idx_b) const
+		{
+			return m_compare(m_keys[m_heap[heap_idx_a]], m_keys[m_heap[heap_idx_b]]);
+		}
+
+		void swap_entries(std::size_t heap_idx_a, std::size_t heap_idx_b) noexcept
+		{
+			std::swap(m_heap[heap_idx_a], m_heap[heap_idx_b]);
+			m_positions[m_heap[heap_idx_a]] = heap_idx_a;
+			m_positions[m_heap[heap_idx_b]] = heap_idx_b;
+		}
+
+		void sift_up(std::size_t heap_idx)
+		{
+			while (heap_idx > 0)
+			{
+				const std::size_t parent = (heap_idx - 1) / 2;
+				if (!is_before(heap_idx, parent)) break;
+				swap_entries(heap_idx, parent);
+				heap_idx = parent;
+			}
+		}
+
+		void sift_down(std::size_t heap_idx)
+		{
+			while (true)
+			{
+				const std::size_t left = 2 * heap_idx + 1;
+				if (left >= m_heap.size()) break;
+				const std::size_t right = left + 1;
+				const std::size_t best_child = (right < m_heap.size() && is_before(right, left)) ? right : left;
+				if (!is_before(best_child, heap_idx)) break;
+				swap_entries(heap_idx, best_child);
+				heap_idx = best_child;
+			}
+		}
+
+		void ensure_handle_storage(std::size_t handle)
+		{
+			if (handle >= m_positions.size())
+			{
+				const std::size_t new_size = std::max(handle + 1, 2 * m_positions.size());
+				m_positions.resize(new_size, npos);
+				m_keys.resize(new_size);
+			}
+		}
+	public:
+		explicit indexed_priority_queue(std::size_t num_handles = 0, Compare compare = Compare{})
+			: m_positions(num_handles, npos)
+			, m_keys(num_handles)
+			, m_compare(std::move(compare))
+		{}
+
+		[[nodiscard]] bool empty() const noexcept { return m_heap.empty(); }
+		[[nodiscard]] std::size_t size() const noexcept { return m_heap.size(); }
+
+		void reserve(std::size_t num_handles)
+		{
+			m_heap.reserve(num_handles);
+			ensure_handle_storage(num_handles > 0 ? num_handles - 1 : 0);
+		}
+
+		bool contains(std::size_t handle) const noexcept
+		{
+			return handle < m_positions.size() && m_positions[handle] != npos;
+		}
+
+		// Only valid while the handle is in the queue.
+		const KeyType& key(std::size_t handle) const
+		{
+			AdventCheck(contains(handle));
+			return m_keys[handle];
+		}
+
+		void push(std::size_t handle, KeyType key)
+		{
+			ensure_handle_storage(handle);
+			AdventCheck(!contains(handle));
+			m_keys[handle] = std::move(key);
+			m_positions[handle] = m_heap.size();
+			m_heap.push_back(handle);
+			sift_up(m_heap.size() - 1);
+		}
+
+		// The new key must not come after the old one.
+		void decrease_key(std::size_t handle, KeyType key)
+		{
+			AdventCheck(contains(handle));
+			AdventCheck(!m_compare(m_keys[handle], key));
+			m_keys[handle] = std::move(key);
+			sift_up(m_positions[handle]);
+		}
+
+		// Pushes the handle, or lowers its key if it is already queued with a worse one.
+		// Returns false if nothing changed.
+		bool push_or_decrease(std::size_t handle, KeyType key)
+		{
+			if (!contains(handle))
+			{
+				push(handle, std::move(key));
+				return true;
+			}
+			if (m_compare(key, m_keys[handle]))
+			{
+				decrease_key(handle, std::move(key));
+				return true;
+			}
+			return false;
+		}
+
+		std::size_t top() const
+		{
+			AdventCheck(!empty());
+			return m_heap.front();
+		}
+
+		const KeyType& top_key() const
+		{
+			return m_keys[top()];
+		}
+
+		std::size_t pop()
+		{
+			const std::size_t result = top();
+			swap_entries(0, m_heap.size() - 1);
+			m_heap.pop_back();
+			m_positions[result] = npos;
+			if (!m_heap.empty())
+			{
+				sift_down(0);
+			}
+			return result;
+		}
+
+		void clear() noexcept
+		{
+			for (std::size_t handle : m_heap)
+			{
+				m_positions[handle] = npos;
+			}
+			m_heap.clear();
+		}
+	};
+}
\ No newline at end of file
@@ -8,22 +8,58 @@
 #include <stdexcept>
 #include <optional>
 
+#include "view_istream.h"
+
 namespace utils
 {
 
+	// Like istream_line_iterator, blocks are handed out as views into the stream's buffer
+	// when it reads from a utils::view_streambuf, rather than being built up line by line.
 	class istream_block_iterator
 	{
 	private:
 		std::istream* m_stream;
+		view_streambuf* m_buffer;
 		std::string_view m_sentinental;
 		bool is_at_end() const { return m_stream == nullptr; }
 		std::optional<std::string> m_cached_result;
+		std::optional<std::string_view> m_cached_view;
+		void read_next_block_from_buffer()
+		{
+			const std::string_view remaining = m_buffer->remaining();
+			std::size_t line_start = 0;
+			while (true)
+			{
+				const std::size_t line_end = remaining.find('\n', line_start);
+				const bool is_last_line = (line_end == remaining.npos);
+				const std::string_view line = remaining.substr(line_start, is_last_line ? remaining.npos : line_end - line_start);
+				if (line == m_sentinental || is_last_line)
+				{
+					// The block is everything before this line, without the '\n' joining them.
+					const std::size_t block_end = (line == m_sentinental) ? (line_start > 0 ? line_start - 1 : 0) : remaining.size();
+					m_cached_view = remaining.substr(0, block_end);
+					m_buffer->consume(is_last_line ? remaining.size() : line_end + 1);
+					if (is_last_line)
+					{
+						m_stream->setstate(std::ios_base::eofbit);
+						m_stream = nullptr;
+					}
+					return;
+				}
+				line_start = line_end + 1;
+			}
+		}
 		void read_next_block()
 		{
 			if (is_at_end())
 			{
 				throw std::range_error{ "Cannot deference an at-the-end stream block iterator" };
 			}
+			if (m_buffer != nullptr)
+			{
+				read_next_block_from_buffer();
+				return;
+			}
 
 			std::ostringstream result_stream;
 			std::string line;
@@ -53,7 +89,7 @@ namespace utils
 		}
 		void maybe_read_next_block()
 		{
-			if (!m_cached_result.has_value())
+			if (!m_cached_result.has_value() && !m_cached_view.has_value())
 			{
 				read_next_block();
 			}
@@ -65,8 +101,8 @@ namespace utils
 		using difference_type = int;
 		using iterator_category = std::input_iterator_tag;
 		explicit istream_block_iterator(std::istream& stream, std::string_view sentinental = "") noexcept
-			: m_stream{ &stream }, m_sentinental{ sentinental }{}
-		istream_block_iterator() noexcept : m_stream{ nullptr }, m_sentinental{}{}
+			: m_stream{ &stream }, m_buffer{ dynamic_cast<view_streambuf*>(stream.rdbuf()) }, m_sentinental{ sentinental }{}
+		istream_block_iterator() noexcept : m_stream{ nullptr }, m_buffer{ nullptr }, m_sentinental{}{}
 		istream_block_iterator(const istream_block_iterator&) noexcept = default;
 		istream_block_iterator& operator=(const istream_block_iterator&) noexcept = default;
 
@@ -83,13 +119,14 @@ namespace utils
 		std::string_view operator*()
 		{
 			maybe_read_next_block();
-			return m_cached_result.value();
+			return m_cached_view.has_value() ? m_cached_view.value() : std::string_view{ m_cached_result.value() };
 		}
 
 		istream_block_iterator& operator++() noexcept
 		{
 			maybe_read_next_block();
 			m_cached_result.reset();
+			m_cached_view.reset();
 			return *this;
 		}
 		istream_block_iterator  operator++(int) noexcept
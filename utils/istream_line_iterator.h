@@ -6,34 +6,67 @@
 #include <stdexcept>
 #include <optional>
 
+#include "view_istream.h"
+
 namespace utils
 {
 
+	// If the stream reads from a utils::view_streambuf, lines are handed out as views
+	// straight into its buffer instead of being copied into a std::string first.
+	// The stream position is kept in step either way, so it can be mixed with std::getline.
 	class istream_line_iterator
 	{
 	private:
 		mutable std::istream* m_stream;
+		mutable view_streambuf* m_buffer;
 		char m_sentinental;
 		bool is_at_end() const { return m_stream == nullptr; }
-		mutable std::optional<std::string> m_cached_result;
+		// Reused from line to line, so reading from other streams does not allocate for every line.
+		mutable std::string m_line;
+		mutable bool m_has_line = false;
+		mutable std::optional<std::string_view> m_cached_view;
+		void read_next_sequence_from_buffer() const
+		{
+			const std::string_view remaining = m_buffer->remaining();
+			const std::size_t line_end = remaining.find(m_sentinental);
+			if (line_end == remaining.npos)
+			{
+				// Same as std::getline running out of input.
+				m_cached_view = remaining;
+				m_buffer->consume(remaining.size());
+				m_stream->setstate(std::ios_base::eofbit);
+				m_stream = nullptr;
+				return;
+			}
+			m_cached_view = remaining.substr(0, line_end);
+			m_buffer->consume(line_end + 1);
+		}
 		void read_next_sequence() const
 		{
 			if (is_at_end())
 			{
 				throw std::range_error{ "Cannot dereference an at-the-end stream line iterator" };
 			}
-			std::string result;
-			std::getline(*m_stream, result, m_sentinental);
-			m_cached_result = std::move(result);
+			if (m_buffer != nullptr)
+			{
+				read_next_sequence_from_buffer();
+				return;
+			}
+			std::getline(*m_stream, m_line, m_sentinental);
+			m_has_line = true;
 
 			if (m_stream->eof())
 			{
 				m_stream = nullptr;
 			}
 		}
+		bool has_cached_result() const noexcept
+		{
+			return m_has_line || m_cached_view.has_value();
+		}
 		void maybe_read_next_sequence() const
 		{
-			if (!m_cached_result.has_value())
+			if (!has_cached_result())
 			{
 				read_next_sequence();
 			}
@@ -45,8 +78,8 @@ namespace utils
 		using difference_type = int;
 		using iterator_category = std::input_iterator_tag;
 		explicit istream_line_iterator(std::istream& stream, char sentinental = '\n') noexcept
-			: m_stream{ &stream },  m_sentinental{ sentinental }{}
-		istream_line_iterator() noexcept : m_stream{ nullptr }, m_sentinental{ 0 }{}
+			: m_stream{ &stream }, m_buffer{ dynamic_cast<view_streambuf*>(stream.rdbuf()) }, m_sentinental{ sentinental }{}
+		istream_line_iterator() noexcept : m_stream{ nullptr }, m_buffer{ nullptr }, m_sentinental{ 0 }{}
 		istream_line_iterator(const istream_line_iterator&) noexcept = default;
 		istream_line_iterator& operator=(const istream_line_iterator&) noexcept = default;
 
@@ -63,13 +96,14 @@ namespace utils
 		std::string_view operator*() const
 		{
 			maybe_read_next_sequence();
-			return m_cached_result.value();
+			return m_cached_view.has_value() ? m_cached_view.value() : std::string_view{ m_line };
 		}
 
 		istream_line_iterator& operator++() noexcept
 		{
 			maybe_read_next_sequence();
-			m_cached_result.reset();
+			m_has_line = false;
+			m_cached_view.reset();
 			return *this;
 		}
 		istream_line_iterator  operator++(int) noexcept
@@ -1,11 +1,21 @@
 #include "../utils/md5.h"
 #include "../utils/int_range.h"
-#include "../utils/range_contains.h"
 
 #include <type_traits>
 #include <numeric>
 #include <algorithm>
 #include <cassert>
+#include <climits>
+#include <bit>
+#include <charconv>
+#include <limits>
+#include <string_view>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
 
 #ifdef NDEBUG
 #define MD5_PRINT_STEPS 0
@@ -27,10 +37,6 @@ namespace
 	using Val = uint32_t;
 	using Block = std::array<Val, BLOCK_LENGTH / sizeof(Val)>;
 	constexpr auto NUM_ROUNDS = 64;
-	void validate_round(int index) noexcept
-	{
-		assert(range_contains_exc(index, 0, NUM_ROUNDS));
-	}
 
 	template <typename Int>
 	uint8_t get_char_in_pos(Int i, int pos) noexcept
@@ -55,162 +61,266 @@ namespace
 		}
 	};
 
-	MD5State operator+(const MD5State& left, const MD5State& right) noexcept
-	{
-		MD5State result = left;
-		result += right;
-		return result;
-	}
+	constexpr std::array<Val, NUM_ROUNDS> K_VALUES{
+		0xd76aa478,0xe8c7b756,0x242070db,0xc1bdceee,0xf57c0faf,0x4787c62a,0xa8304613,0xfd469501,
+		0x698098d8,0x8b44f7af,0xffff5bb1,0x895cd7be,0x6b901122,0xfd987193,0xa679438e,0x49b40821,
+		0xf61e2562,0xc040b340,0x265e5a51,0xe9b6c7aa,0xd62f105d,0x02441453,0xd8a1e681,0xe7d3fbc8,
+		0x21e1cde6,0xc33707d6,0xf4d50d87,0x455a14ed,0xa9e3e905,0xfcefa3f8,0x676f02d9,0x8d2a4c8a,
+		0xfffa3942,0x8771f681,0x6d9d6122,0xfde5380c,0xa4beea44,0x4bdecfa9,0xf6bb4b60,0xbebfbc70,
+		0x289b7ec6,0xeaa127fa,0xd4ef3085,0x04881d05,0xd9d4d039,0xe6db99e5,0x1fa27cf8,0xc4ac5665,
+		0xf4292244,0x432aff97,0xab9423a7,0xfc93a039,0x655b59c3,0x8f0ccc92,0xffeff47d,0x85845dd1,
+		0x6fa87e4f,0xfe2ce6e0,0xa3014314,0x4e0811a1,0xf7537e82,0xbd3af235,0x2ad7d2bb,0xeb86d391
+	};
 
-	uint8_t get_shift_amount(int index) noexcept
-	{
-		const std::array<uint8_t,64> values{
-			7,12,17,22,	7,12,17,22,	7,12,17,22,	7,12,17,22,
-			5, 9,14,20,	5, 9,14,20,	5, 9,14,20,	5, 9,14,20,
-			4,11,16,23,	4,11,16,23,	4,11,16,23,	4,11,16,23,
-			6,10,15,21,	6,10,15,21,	6,10,15,21,	6,10,15,21
-		};
-		assert(range_contains_exc<int>(index, 0, static_cast<int>(values.size())));
-		return values[index];
-	}
+	constexpr std::array<int, NUM_ROUNDS> SHIFT_AMOUNTS{
+		7,12,17,22,	7,12,17,22,	7,12,17,22,	7,12,17,22,
+		5, 9,14,20,	5, 9,14,20,	5, 9,14,20,	5, 9,14,20,
+		4,11,16,23,	4,11,16,23,	4,11,16,23,	4,11,16,23,
+		6,10,15,21,	6,10,15,21,	6,10,15,21,	6,10,15,21
+	};
 
-	uint8_t get_block_index(int index) noexcept
+	constexpr int get_block_index(int index) noexcept
 	{
-		const auto result = [index]()
+		switch (index / 16)
 		{
-			switch (index / 16)
-			{
-			default:
-				assert(false);
-				return -1;
-			case 0:
-				return index;
-			case 1:
-				return 5 * index + 1;
-			case 2:
-				return 3 * index + 5;
-			case 3:
-				return 7 * index;
-			}
-		}();
-		return static_cast<uint8_t>(result % 16);
+		case 0:
+			return index;
+		case 1:
+			return (5 * index + 1) % 16;
+		case 2:
+			return (3 * index + 5) % 16;
+		default:
+			return (7 * index) % 16;
+		}
 	}
 
-	Val calculate_k_value(int index) noexcept
+	// Each of these does the same operation on every 32-bit lane of V, so the rounds below
+	// are written once and hash WIDTH messages at a time.
+	struct ScalarLanes
 	{
-		validate_round(index);
-		return static_cast<Val>(static_cast<double>(0x1'0000'0000) * std::abs(std::sin(index + 1)));
-	}
+		using V = Val;
+		static constexpr std::size_t WIDTH = 1;
+		static V load(const Val* p) noexcept { return *p; }
+		static void store(Val* p, V v) noexcept { *p = v; }
+		static V set1(Val x) noexcept { return x; }
+		static V add(V l, V r) noexcept { return l + r; }
+		static V bit_and(V l, V r) noexcept { return l & r; }
+		static V bit_or(V l, V r) noexcept { return l | r; }
+		static V bit_xor(V l, V r) noexcept { return l ^ r; }
+		static V bit_not(V v) noexcept { return ~v; }
+		template <int DISTANCE>
+		static V rotate_left(V v) noexcept { return std::rotl(v, DISTANCE); }
+	};
 
-	std::array<Val, NUM_ROUNDS> calculate_all_k_vals() noexcept
+#if defined(__AVX512F__)
+#define AOC_MD5_AVX512
+	struct SimdLanes
 	{
-		std::array<Val, NUM_ROUNDS> result;
-		const auto range = int_range(static_cast<int>(result.size()));
-		std::transform(begin(range), end(range), begin(result), calculate_k_value);
-		return result;
-	}
-
-	const std::array<Val, NUM_ROUNDS> all_k_vals = calculate_all_k_vals();
+		using V = __m512i;
+		static constexpr std::size_t WIDTH = 16;
+		static V load(const Val* p) noexcept { return _mm512_loadu_si512(p); }
+		static void store(Val* p, V v) noexcept { _mm512_storeu_si512(p, v); }
+		static V set1(Val x) noexcept { return _mm512_set1_epi32(static_cast<int>(x)); }
+		static V add(V l, V r) noexcept { return _mm512_add_epi32(l, r); }
+		static V bit_and(V l, V r) noexcept { return _mm512_and_si512(l, r); }
+		static V bit_or(V l, V r) noexcept { return _mm512_or_si512(l, r); }
+		static V bit_xor(V l, V r) noexcept { return _mm512_xor_si512(l, r); }
+		static V bit_not(V v) noexcept { return _mm512_xor_si512(v, _mm512_set1_epi32(-1)); }
+		template <int DISTANCE>
+		static V rotate_left(V v) noexcept { return _mm512_rol_epi32(v, DISTANCE); }
+	};
+#elif defined(__AVX2__)
+#define AOC_MD5_AVX2
+	struct SimdLanes
+	{
+		using V = __m256i;
+		static constexpr std::size_t WIDTH = 8;
+		static V load(const Val* p) noexcept { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+		static void store(Val* p, V v) noexcept { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+		static V set1(Val x) noexcept { return _mm256_set1_epi32(static_cast<int>(x)); }
+		static V add(V l, V r) noexcept { return _mm256_add_epi32(l, r); }
+		static V bit_and(V l, V r) noexcept { return _mm256_and_si256(l, r); }
+		static V bit_or(V l, V r) noexcept { return _mm256_or_si256(l, r); }
+		static V bit_xor(V l, V r) noexcept { return _mm256_xor_si256(l, r); }
+		static V bit_not(V v) noexcept { return _mm256_xor_si256(v, _mm256_set1_epi32(-1)); }
+		template <int DISTANCE>
+		static V rotate_left(V v) noexcept { return _mm256_or_si256(_mm256_slli_epi32(v, DISTANCE), _mm256_srli_epi32(v, 32 - DISTANCE)); }
+	};
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AOC_MD5_SSE2
+	struct SimdLanes
+	{
+		using V = __m128i;
+		static constexpr std::size_t WIDTH = 4;
+		static V load(const Val* p) noexcept { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+		static void store(Val* p, V v) noexcept { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+		static V set1(Val x) noexcept { return _mm_set1_epi32(static_cast<int>(x)); }
+		static V add(V l, V r) noexcept { return _mm_add_epi32(l, r); }
+		static V bit_and(V l, V r) noexcept { return _mm_and_si128(l, r); }
+		static V bit_or(V l, V r) noexcept { return _mm_or_si128(l, r); }
+		static V bit_xor(V l, V r) noexcept { return _mm_xor_si128(l, r); }
+		static V bit_not(V v) noexcept { return _mm_xor_si128(v, _mm_set1_epi32(-1)); }
+		template <int DISTANCE>
+		static V rotate_left(V v) noexcept { return _mm_or_si128(_mm_slli_epi32(v, DISTANCE), _mm_srli_epi32(v, 32 - DISTANCE)); }
+	};
+#else
+	using SimdLanes = ScalarLanes;
+#endif
 
-	Val get_k_val(int index) noexcept
+	template <typename Lanes, int INDEX>
+	inline void do_round(typename Lanes::V (&state)[4], const typename Lanes::V (&block)[16]) noexcept
 	{
-		validate_round(index);
-		return all_k_vals[index];
+		using V = typename Lanes::V;
+		V& A = state[(64 - INDEX) % 4];
+		const V B = state[(65 - INDEX) % 4];
+		const V C = state[(66 - INDEX) % 4];
+		const V D = state[(67 - INDEX) % 4];
+		V f;
+		if constexpr (INDEX < 16)
+		{
+			f = Lanes::bit_xor(D, Lanes::bit_and(B, Lanes::bit_xor(C, D)));
+		}
+		else if constexpr (INDEX < 32)
+		{
+			f = Lanes::bit_xor(C, Lanes::bit_and(D, Lanes::bit_xor(B, C)));
+		}
+		else if constexpr (INDEX < 48)
+		{
+			f = Lanes::bit_xor(Lanes::bit_xor(B, C), D);
+		}
+		else
+		{
+			f = Lanes::bit_xor(C, Lanes::bit_or(B, Lanes::bit_not(D)));
+		}
+		const V k_plus_m = Lanes::add(Lanes::set1(K_VALUES[INDEX]), block[get_block_index(INDEX)]);
+		A = Lanes::add(Lanes::add(A, f), k_plus_m);
+		A = Lanes::add(Lanes::template rotate_left<SHIFT_AMOUNTS[INDEX]>(A), B);
 	}
 
-	Val func0(Val B, Val C, Val D) noexcept
+	template <typename Lanes, int...INDICES>
+	inline void do_all_rounds(typename Lanes::V (&state)[4], const typename Lanes::V (&block)[16], std::integer_sequence<int, INDICES...>) noexcept
 	{
-		return (B & C) | (~B & D);
+		(do_round<Lanes, INDICES>(state, block), ...);
 	}
 
-	Val func1(Val B, Val C, Val D) noexcept
+	// Runs one block through each lane's state. Both are laid out word by word: word i of lane l is at [i * WIDTH + l].
+	template <typename Lanes>
+	void compress_lanes(Val* states, const Val* blocks) noexcept
 	{
-		return (D & B) | (~D & C);
+		using V = typename Lanes::V;
+		V state[4];
+		V initial[4];
+		V block[16];
+		for (std::size_t i = 0; i < 4; ++i)
+		{
+			initial[i] = state[i] = Lanes::load(states + i * Lanes::WIDTH);
+		}
+		for (std::size_t i = 0; i < 16; ++i)
+		{
+			block[i] = Lanes::load(blocks + i * Lanes::WIDTH);
+		}
+		do_all_rounds<Lanes>(state, block, std::make_integer_sequence<int, NUM_ROUNDS>{});
+		for (std::size_t i = 0; i < 4; ++i)
+		{
+			Lanes::store(states + i * Lanes::WIDTH, Lanes::add(state[i], initial[i]));
+		}
 	}
 
-	Val func2(Val B, Val C, Val D) noexcept
+	// Runs blocks[i] through states[i] for every i, SimdLanes::WIDTH at a time.
+	void compress_many(std::span<MD5State> states, std::span<const Block> blocks) noexcept
 	{
-		return B ^ C ^ D;
+		assert(states.size() == blocks.size());
+		constexpr std::size_t WIDTH = SimdLanes::WIDTH;
+		for (std::size_t first = 0; first < states.size(); first += WIDTH)
+		{
+			const std::size_t num_lanes = std::min(WIDTH, states.size() - first);
+			alignas(64) std::array<Val, 4 * WIDTH> lane_states{};
+			alignas(64) std::array<Val, 16 * WIDTH> lane_blocks{};
+			for (std::size_t lane = 0; lane < num_lanes; ++lane)
+			{
+				for (std::size_t i = 0; i < 4; ++i)
+				{
+					lane_states[i * WIDTH + lane] = states[first + lane].vals[i];
+				}
+				for (std::size_t i = 0; i < 16; ++i)
+				{
+					lane_blocks[i * WIDTH + lane] = blocks[first + lane][i];
+				}
+			}
+			compress_lanes<SimdLanes>(lane_states.data(), lane_blocks.data());
+			for (std::size_t lane = 0; lane < num_lanes; ++lane)
+			{
+				for (std::size_t i = 0; i < 4; ++i)
+				{
+					states[first + lane].vals[i] = lane_states[i * WIDTH + lane];
+				}
+			}
+		}
 	}
 
-	Val func3(Val B, Val C, Val D) noexcept
+	Block make_block(const uint8_t* bytes) noexcept
 	{
-		return C ^ (B | ~D);
+		Block result;
+		for (std::size_t i = 0; i < result.size(); ++i)
+		{
+			const uint8_t* word = bytes + i * sizeof(Val);
+			result[i] = Val{ word[0] } | (Val{ word[1] } << 8) | (Val{ word[2] } << 16) | (Val{ word[3] } << 24);
+		}
+		return result;
 	}
 
-	Val func(int i, Val B, Val C, Val D) noexcept
+	// Pads a message short enough to fit in one block. Its bytes are already at the start of buffer.
+	void pad_single_block(std::array<uint8_t, BLOCK_LENGTH>& buffer, std::size_t message_size) noexcept
 	{
-		validate_round(i);
-		switch (i / 16)
+		assert(message_size <= MD5_SINGLE_BLOCK_MAX_SIZE);
+		buffer[message_size] = 0x80;
+		std::fill(begin(buffer) + message_size + 1, end(buffer) - sizeof(uint64_t), uint8_t{ 0 });
+		const uint64_t num_bits = message_size * CHAR_BIT;
+		for (auto i : int_range<int>(sizeof(uint64_t)))
 		{
-		default:
-			assert(false);
-			return 0;
-		case 0:
-			return func0(B, C, D);
-		case 1:
-			return func1(B, C, D);
-		case 2:
-			return func2(B, C, D);
-		case 3:
-			return func3(B, C, D);
+			buffer[BLOCK_LENGTH - sizeof(uint64_t) + i] = get_char_in_pos(num_bits, i);
 		}
-		return 0;
 	}
 
-	struct RoundResult
+	// A number kept as decimal digits, so counting up does not redo the conversion each time.
+	class DecimalCounter
 	{
-		Val func_result;
-		Val k_value;
-		uint8_t block_index;
-		uint8_t shift_amount;
-	};
+		std::array<char, std::numeric_limits<uint64_t>::digits10 + 1> m_digits;
+		std::size_t m_first_digit;
+	public:
+		explicit DecimalCounter(uint64_t value) noexcept
+		{
+			const auto [ptr, ec] = std::to_chars(m_digits.data(), m_digits.data() + m_digits.size(), value);
+			assert(ec == std::errc{});
+			const std::size_t num_digits = ptr - m_digits.data();
+			m_first_digit = m_digits.size() - num_digits;
+			std::copy_backward(m_digits.data(), ptr, m_digits.data() + m_digits.size());
+		}
 
-	RoundResult get_round_result(Val A, Val B, Val C, Val D, int index) noexcept
-	{
-		validate_round(index);
-		return RoundResult{
-			func(index, B, C, D),
-			get_k_val(index),
-			get_block_index(index),
-			get_shift_amount(index)
-		};
-	}
+		std::string_view get_digits() const noexcept
+		{
+			return std::string_view{ m_digits.data() + m_first_digit, m_digits.size() - m_first_digit };
+		}
 
-	template <typename UInt>
-	UInt lrotate_bits(UInt val, uint8_t distance) noexcept
-	{
-		static_assert(std::is_integral_v<UInt>);
-		static_assert(std::is_unsigned_v<UInt>);
-		constexpr auto num_bits = sizeof(val) * CHAR_BIT;
-		assert(distance < num_bits);
-
-		const auto new_bottom_bits = val >> (num_bits - distance);
-		const auto new_top_bits = val << distance;
-		assert((new_bottom_bits & new_top_bits) == 0);
-		return new_top_bits + new_bottom_bits;
-	}
+		void increment() noexcept
+		{
+			for (std::size_t i = m_digits.size(); i-- > m_first_digit; )
+			{
+				if (m_digits[i] != '9')
+				{
+					++m_digits[i];
+					return;
+				}
+				m_digits[i] = '0';
+			}
+			assert(m_first_digit > 0);
+			m_digits[--m_first_digit] = '1';
+		}
+	};
 
-	MD5State do_round(MD5State state, const Block& block, int index) noexcept
+	MD5Digest to_digest(const MD5State& state) noexcept
 	{
-#if MD5_PRINT_STEPS
-		std::printf("MD5 state Pass %d; a=%08x b=%08x c=%08x d=%08x\n",
-			index, state.vals[0], state.vals[1], state.vals[2], state.vals[3]);
-#endif
-		auto get_rotated = [&state, index](int i) -> Val&
-		{
-			const auto idx = 64 + i - index;
-			return state.vals[idx % 4];
-		};
-		auto& A = get_rotated(0);
-		auto& B = get_rotated(1);
-		auto& C = get_rotated(2);
-		auto& D = get_rotated(3);
-		const auto rr = get_round_result(A,B,C,D, index);
-		assert(rr.block_index < block.size());
-		A = rr.func_result + A + rr.k_value + block[rr.block_index];
-		A = lrotate_bits(A, rr.shift_amount) + B;
-		return state;
+		return MD5Digest{ state.vals[0],state.vals[1],state.vals[2],state.vals[3] };
 	}
 
 	MD5State hash_block(const MD5State& state, const Block& block) noexcept
@@ -223,12 +333,8 @@ namespace
 		}
 		printf("}\n");
 #endif
-		const auto range = int_range(NUM_ROUNDS);
-		const auto result = std::accumulate(begin(range), end(range), state,
-			[&block](const MD5State& s, int index)
-		{
-			return do_round(s, block, index);
-		});
+		MD5State result = state;
+		compress_lanes<ScalarLanes>(result.vals.data(), block.data());
 #if MD5_PRINT_STEPS
 		std::printf("MD5 state Pass %d; a=%08x b=%08x c=%08x d=%08x\n",
 			64, result.vals[0], result.vals[1], result.vals[2], result.vals[3]);
@@ -237,6 +343,150 @@ namespace
 	}
 }
 
+std::size_t utils::md5_num_lanes() noexcept
+{
+	return SimdLanes::WIDTH;
+}
+
+void utils::get_digests(std::span<const std::string_view> messages, std::span<MD5Digest> out)
+{
+	assert(messages.size() == out.size());
+	constexpr std::size_t BATCH_SIZE = 64;
+	std::array<MD5State, BATCH_SIZE> states;
+	std::array<Block, BATCH_SIZE> blocks;
+	std::array<std::size_t, BATCH_SIZE> out_indices;
+	std::size_t batch_size = 0;
+	auto flush = [&]()
+	{
+		compress_many(std::span{ states.data(), batch_size }, std::span{ blocks.data(), batch_size });
+		for (std::size_t i = 0; i < batch_size; ++i)
+		{
+			out[out_indices[i]] = to_digest(states[i]);
+		}
+		batch_size = 0;
+	};
+
+	for (std::size_t i = 0; i < messages.size(); ++i)
+	{
+		const std::string_view message = messages[i];
+		if (message.size() > MD5_SINGLE_BLOCK_MAX_SIZE)
+		{
+			out[i] = get_digest(message);
+			continue;
+		}
+		std::array<uint8_t, BLOCK_LENGTH> buffer;
+		std::copy(begin(message), end(message), buffer.data());
+		pad_single_block(buffer, message.size());
+		states[batch_size] = MD5State{};
+		blocks[batch_size] = make_block(buffer.data());
+		out_indices[batch_size] = i;
+		if (++batch_size == BATCH_SIZE)
+		{
+			flush();
+		}
+	}
+	flush();
+}
+
+MD5CounterHasher::MD5CounterHasher(std::string_view prefix) noexcept
+	: m_prefix_size{ prefix.size() }
+{
+	MD5State state;
+	while (prefix.size() >= BLOCK_LENGTH)
+	{
+		std::array<uint8_t, BLOCK_LENGTH> bytes;
+		std::copy(begin(prefix), begin(prefix) + BLOCK_LENGTH, bytes.data());
+		state = hash_block(state, make_block(bytes.data()));
+		prefix.remove_prefix(BLOCK_LENGTH);
+	}
+	m_prefix_state = state.vals;
+	m_prefix_tail_size = prefix.size();
+	std::copy(begin(prefix), end(prefix), m_prefix_tail.data());
+}
+
+MD5Digest MD5CounterHasher::get_digest(uint64_t counter) const noexcept
+{
+	MD5Digest result;
+	get_digests(counter, std::span{ &result, 1 });
+	return result;
+}
+
+void MD5CounterHasher::get_digests(uint64_t first_counter, std::span<MD5Digest> out) const noexcept
+{
+	// Long prefixes can push the counter into a second block. Those lanes get another pass.
+	constexpr std::size_t BATCH_SIZE = 64;
+	std::array<MD5State, BATCH_SIZE> states;
+	std::array<Block, BATCH_SIZE> blocks;
+	std::array<MD5State, BATCH_SIZE> second_states;
+	std::array<Block, BATCH_SIZE> second_blocks;
+	std::array<std::size_t, BATCH_SIZE> second_indices;
+	MD5State prefix_state;
+	prefix_state.vals = m_prefix_state;
+
+	// The prefix's tail bytes never change, so each message starts as a copy of these blocks
+	// with the counter, padding and length OR'd in.
+	std::array<Block, 2> prefix_blocks;
+	{
+		std::array<uint8_t, 2 * BLOCK_LENGTH> bytes{};
+		std::copy(begin(m_prefix_tail), begin(m_prefix_tail) + m_prefix_tail_size, bytes.data());
+		prefix_blocks[0] = make_block(bytes.data());
+		prefix_blocks[1] = make_block(bytes.data() + BLOCK_LENGTH);
+	}
+	DecimalCounter counter{ first_counter };
+
+	while (!out.empty())
+	{
+		const std::size_t batch_size = std::min(BATCH_SIZE, out.size());
+		std::size_t num_second = 0;
+		for (std::size_t i = 0; i < batch_size; ++i, counter.increment())
+		{
+			std::array<Block, 2> message = prefix_blocks;
+			Val* words = message[0].data();
+			auto set_byte = [words](std::size_t pos, uint8_t byte)
+			{
+				words[pos / sizeof(Val)] |= Val{ byte } << (CHAR_BIT * (pos % sizeof(Val)));
+			};
+			const std::string_view digits = counter.get_digits();
+			std::size_t pos = m_prefix_tail_size;
+			for (char digit : digits)
+			{
+				set_byte(pos++, static_cast<uint8_t>(digit));
+			}
+			set_byte(pos++, 0x80);
+			const bool needs_second_block = pos + sizeof(uint64_t) > BLOCK_LENGTH;
+			const uint64_t num_bits = (m_prefix_size + digits.size()) * CHAR_BIT;
+			Block& last_block = message[needs_second_block ? 1 : 0];
+			last_block[14] = static_cast<Val>(num_bits);
+			last_block[15] = static_cast<Val>(num_bits >> 32);
+			states[i] = prefix_state;
+			blocks[i] = message[0];
+			if (needs_second_block)
+			{
+				second_blocks[num_second] = message[1];
+				second_indices[num_second++] = i;
+			}
+		}
+		compress_many(std::span{ states.data(), batch_size }, std::span{ blocks.data(), batch_size });
+		if (num_second > 0)
+		{
+			for (std::size_t i = 0; i < num_second; ++i)
+			{
+				second_states[i] = states[second_indices[i]];
+			}
+			compress_many(std::span{ second_states.data(), num_second }, std::span{ second_blocks.data(), num_second });
+			for (std::size_t i = 0; i < num_second; ++i)
+			{
+				states[second_indices[i]] = second_states[i];
+			}
+		}
+		for (std::size_t i = 0; i < batch_size; ++i)
+		{
+			out[i] = to_digest(states[i]);
+		}
+		out = out.subspan(batch_size);
+	}
+}
+
 MD5Digest MD5Hasher::get_digest() const noexcept
 {
 #if MD5_PRINT_STEPS
@@ -261,15 +511,11 @@ MD5Digest MD5Hasher::get_digest() const noexcept
 		push_char_non_msg(get_char_in_pos(suffix, i), fake_size++);
 	}
 	assert(fake_size % BLOCK_LENGTH == 0);
-	const auto result = std::accumulate(begin(blocks), end(blocks), MD5State{},
-		[](const MD5State& s, const Block& b)
-	{
-		return s + hash_block(s, b);
-	});
+	const auto result = std::accumulate(begin(blocks), end(blocks), MD5State{}, hash_block);
 #if MD5_PRINT_STEPS
 	printf("MD5 State final: a=%08x b=%08x, c=%08x d=%08x\n", result.vals[0], result.vals[1], result.vals[2], result.vals[3]);
 #endif
-	return MD5Digest{ result.vals[0],result.vals[1],result.vals[2],result.vals[3] };
+	return to_digest(result);
 }
 
 void MD5Hasher::push_char_non_msg(uint8_t c, uint64_t location) const noexcept
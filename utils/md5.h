@@ -6,6 +6,9 @@
 #include <iomanip>
 #include <array>
 #include <vector>
+#include <span>
+#include <string_view>
+#include <cstdint>
 
 namespace utils
 {
@@ -14,6 +17,7 @@ namespace utils
 	private:
 		uint32_t a, b, c, d;
 	public:
+		MD5Digest() noexcept : MD5Digest{ 0, 0, 0, 0 } {}
 		MD5Digest(uint32_t A, uint32_t B, uint32_t C, uint32_t D) noexcept
 			: a{ A }, b{ B }, c{ C }, d{ D }{}
 		auto operator<=>(const MD5Digest& other) const noexcept = default;
@@ -72,6 +76,52 @@ namespace utils
 		return hasher.get_digest();
 	}
 
+	// The longest message that fits in a single MD5 block along with its padding.
+	constexpr std::size_t MD5_SINGLE_BLOCK_MAX_SIZE = 55;
+
+	// How many messages get_digests hashes at once in this build:
+	// 16 with AVX-512, 8 with AVX2, 4 with SSE2 and 1 otherwise.
+	std::size_t md5_num_lanes() noexcept;
+
+	// Hashes many independent messages, one per SIMD lane. out must be the same size as messages.
+	// Messages longer than MD5_SINGLE_BLOCK_MAX_SIZE work, but are hashed one at a time.
+	void get_digests(std::span<const std::string_view> messages, std::span<MD5Digest> out);
+
+	// Hashes a fixed prefix followed by a decimal counter (e.g. "abcdef609043"), for nonce searches.
+	// The prefix's whole blocks are hashed once up front and nothing is allocated per digest.
+	class MD5CounterHasher
+	{
+		std::array<uint32_t, 4> m_prefix_state;
+		std::array<uint8_t, 64> m_prefix_tail;
+		std::size_t m_prefix_tail_size;
+		uint64_t m_prefix_size;
+	public:
+		explicit MD5CounterHasher(std::string_view prefix) noexcept;
+
+		MD5Digest get_digest(uint64_t counter) const noexcept;
+
+		// out[i] gets the digest for first_counter + i.
+		void get_digests(uint64_t first_counter, std::span<MD5Digest> out) const noexcept;
+
+		// The first counter from first_counter onwards whose digest satisfies pred.
+		template <typename Pred>
+		uint64_t find_first(uint64_t first_counter, Pred pred) const
+		{
+			std::array<MD5Digest, 64> batch;
+			for (uint64_t base = first_counter; ; base += batch.size())
+			{
+				get_digests(base, batch);
+				for (std::size_t i = 0; i < batch.size(); ++i)
+				{
+					if (pred(batch[i]))
+					{
+						return base + i;
+					}
+				}
+			}
+		}
+	};
+
 	class MD5InputIterator
 	{
 	public:
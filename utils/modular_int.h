@@ -3,9 +3,28 @@
 #include <type_traits>
 #include <istream>
 #include <ostream>
+#include <cstdint>
+#include <concepts>
+#include <limits>
+#include <span>
+#include <utility>
 
 #include "../advent/advent_assert.h"
 
+#if defined(__AVX2__)
+#define AOC_MONTGOMERY_SIMD 2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AOC_MONTGOMERY_SIMD 1
+#include <emmintrin.h>
+#else
+#define AOC_MONTGOMERY_SIMD 0
+#endif
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
 namespace utils
 {
 	enum class modular_undwind_policy
@@ -149,7 +168,7 @@ namespace utils
 		constexpr modular& operator*=(OtherType operand)
 		{
 			force_unwind_val();
-			m_val += operand;
+			m_val *= operand;
 			maybe_unwind_val();
 			return *this;
 		}
@@ -189,6 +208,346 @@ namespace utils
 		}
 		constexpr IntType get_range() { return m_max_val - m_min_val; }
 	};
+
+	namespace modular_internal
+	{
+		template <typename UInt>
+		struct wide_product
+		{
+			UInt high;
+			UInt low;
+		};
+
+		template <typename UInt>
+		constexpr wide_product<UInt> multiply_wide(UInt a, UInt b) noexcept
+		{
+			constexpr int BITS = std::numeric_limits<UInt>::digits;
+			if constexpr (BITS <= 32)
+			{
+				const uint64_t product = uint64_t{ a } * b;
+				return { static_cast<UInt>(product >> BITS), static_cast<UInt>(product) };
+			}
+			else
+			{
+#if defined(__SIZEOF_INT128__)
+				const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+				return { static_cast<UInt>(product >> 64), static_cast<UInt>(product) };
+#else
+#if defined(_MSC_VER) && defined(_M_X64)
+				if (!std::is_constant_evaluated())
+				{
+					UInt high = 0;
+					const UInt low = _umul128(a, b, &high);
+					return { high, low };
+				}
+#endif
+				const uint64_t a_lo = a & 0xFFFF'FFFF, a_hi = a >> 32;
+				const uint64_t b_lo = b & 0xFFFF'FFFF, b_hi = b >> 32;
+				const uint64_t lo_lo = a_lo * b_lo;
+				const uint64_t hi_lo = a_hi * b_lo;
+				const uint64_t lo_hi = a_lo * b_hi;
+				const uint64_t hi_hi = a_hi * b_hi;
+				const uint64_t middle = (lo_lo >> 32) + (hi_lo & 0xFFFF'FFFF) + lo_hi;
+				return { hi_hi + (hi_lo >> 32) + (middle >> 32), (middle << 32) | (lo_lo & 0xFFFF'FFFF) };
+#endif
+			}
+		}
+	}
+
+	// A fixed odd modulus, set up for Montgomery multiplication: values are kept as x*R mod n
+	// (R = 2^32 or 2^64), which turns the divide in each modular multiply into two multiplies and a shift.
+	// The modulus must be odd and below 2^31 (or 2^63). For anything else, use modular.
+	template <typename UInt>
+	class montgomery_modulus
+	{
+		static_assert(std::is_same_v<UInt, uint32_t> || std::is_same_v<UInt, uint64_t>, "montgomery_modulus supports uint32_t and uint64_t.");
+		static constexpr int BITS = std::numeric_limits<UInt>::digits;
+		UInt m_modulus;
+		UInt m_neg_inverse; // -1/n mod R
+		UInt m_r_squared; // R^2 mod n
+
+		constexpr UInt reduce(modular_internal::wide_product<UInt> t) const noexcept
+		{
+			// t + m*n is a multiple of R, so the low halves add to 0 with a carry unless both are 0.
+			const UInt m = t.low * m_neg_inverse;
+			const UInt carry = t.low != 0 ? 1 : 0;
+			const UInt result = t.high + modular_internal::multiply_wide(m, m_modulus).high + carry;
+			return result >= m_modulus ? result - m_modulus : result;
+		}
+	public:
+		constexpr explicit montgomery_modulus(UInt modulus) : m_modulus{ modulus }, m_neg_inverse{ 0 }, m_r_squared{ 0 }
+		{
+			if (!std::is_constant_evaluated())
+			{
+				AdventCheckMsg(modulus % 2 == 1 && modulus < (UInt{ 1 } << (BITS - 1)), "montgomery_modulus needs an odd modulus below 2^", BITS - 1, ". Got", modulus);
+			}
+
+			// Newton's method doubles the number of correct low bits each step, and n is its own inverse mod 8.
+			UInt inverse = modulus;
+			for (int correct_bits = 3; correct_bits < BITS; correct_bits *= 2)
+			{
+				inverse *= UInt{ 2 } - modulus * inverse;
+			}
+			m_neg_inverse = UInt{ 0 } - inverse;
+
+			// Double R mod n another BITS times to get R^2 mod n. n < R/2, so nothing overflows.
+			UInt r_squared = (UInt{ 0 } - modulus) % modulus;
+			for (int i = 0; i < BITS; ++i)
+			{
+				r_squared <<= 1;
+				r_squared = r_squared >= modulus ? r_squared - modulus : r_squared;
+			}
+			m_r_squared = r_squared;
+		}
+
+		constexpr UInt get_modulus() const noexcept { return m_modulus; }
+
+		// Converting in and out of Montgomery form. The input to to_form must already be below the modulus.
+		constexpr UInt to_form(UInt value) const noexcept { return multiply(value, m_r_squared); }
+		constexpr UInt from_form(UInt form) const noexcept { return reduce({ 0, form }); }
+
+		// Maths on values in Montgomery form.
+		constexpr UInt add(UInt a, UInt b) const noexcept
+		{
+			const UInt result = a + b;
+			return result >= m_modulus ? result - m_modulus : result;
+		}
+		constexpr UInt subtract(UInt a, UInt b) const noexcept
+		{
+			return a >= b ? a - b : a + (m_modulus - b);
+		}
+		constexpr UInt multiply(UInt a, UInt b) const noexcept
+		{
+			return reduce(modular_internal::multiply_wide(a, b));
+		}
+		constexpr UInt pow(UInt base, uint64_t exponent) const noexcept
+		{
+			UInt result = to_form(m_modulus == 1 ? 0 : 1);
+			while (exponent > 0)
+			{
+				if (exponent % 2 == 1)
+				{
+					result = multiply(result, base);
+				}
+				base = multiply(base, base);
+				exponent /= 2;
+			}
+			return result;
+		}
+
+		// out[i] = a[i] * b[i], all in Montgomery form. For uint32_t this uses SSE2 or AVX2 where available.
+		// There are no 64x64-bit vector multiplies, so uint64_t always takes the scalar path.
+		void multiply(std::span<const UInt> a, std::span<const UInt> b, std::span<UInt> out) const noexcept
+		{
+			AdventCheck(a.size() == b.size() && a.size() == out.size());
+			std::size_t i = 0;
+#if AOC_MONTGOMERY_SIMD
+			if constexpr (BITS == 32)
+			{
+				i = multiply_simd(a, b, out);
+			}
+#endif
+			for (; i < out.size(); ++i)
+			{
+				out[i] = multiply(a[i], b[i]);
+			}
+		}
+
+	private:
+#if AOC_MONTGOMERY_SIMD == 2
+		// Four products per step: each 32-bit value sits in the bottom of a 64-bit lane.
+		std::size_t multiply_simd(std::span<const UInt> a, std::span<const UInt> b, std::span<UInt> out) const noexcept
+		{
+			const __m256i modulus = _mm256_set1_epi64x(m_modulus);
+			const __m256i neg_inverse = _mm256_set1_epi64x(m_neg_inverse);
+			const __m256i pack = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+			std::size_t i = 0;
+			for (; i + 4 <= out.size(); i += 4)
+			{
+				const __m256i x = _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a.data() + i)));
+				const __m256i y = _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b.data() + i)));
+				const __m256i t = _mm256_mul_epu32(x, y);
+				const __m256i m = _mm256_mul_epu32(t, neg_inverse);
+				const __m256i r = _mm256_srli_epi64(_mm256_add_epi64(t, _mm256_mul_epu32(m, modulus)), 32);
+				const __m256i below_modulus = _mm256_cmpgt_epi64(modulus, r);
+				const __m256i result = _mm256_sub_epi64(r, _mm256_andnot_si256(below_modulus, modulus));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out.data() + i), _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(result, pack)));
+			}
+			return i;
+		}
+#elif AOC_MONTGOMERY_SIMD == 1
+		// Two products per step: each 32-bit value sits in the bottom of a 64-bit lane.
+		std::size_t multiply_simd(std::span<const UInt> a, std::span<const UInt> b, std::span<UInt> out) const noexcept
+		{
+			const __m128i modulus = _mm_set1_epi64x(m_modulus);
+			const __m128i neg_inverse = _mm_set1_epi64x(m_neg_inverse);
+			const __m128i zero = _mm_setzero_si128();
+			std::size_t i = 0;
+			for (; i + 2 <= out.size(); i += 2)
+			{
+				const __m128i x = _mm_unpacklo_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(a.data() + i)), zero);
+				const __m128i y = _mm_unpacklo_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(b.data() + i)), zero);
+				const __m128i t = _mm_mul_epu32(x, y);
+				const __m128i m = _mm_mul_epu32(t, neg_inverse);
+				const __m128i r = _mm_srli_epi64(_mm_add_epi64(t, _mm_mul_epu32(m, modulus)), 32);
+				// r - n is negative (its top half all ones) if r was already below n. Then add n back.
+				const __m128i difference = _mm_sub_epi64(r, modulus);
+				const __m128i was_below = _mm_shuffle_epi32(_mm_srai_epi32(difference, 31), _MM_SHUFFLE(3, 3, 1, 1));
+				const __m128i result = _mm_add_epi64(difference, _mm_and_si128(was_below, modulus));
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(out.data() + i), _mm_shuffle_epi32(result, _MM_SHUFFLE(3, 1, 2, 0)));
+			}
+			return i;
+		}
+#endif
+	};
+
+	// A number modulo a fixed odd modulus, using montgomery_modulus so multiplying does not divide.
+	// With MODULUS = 0 the modulus is given at runtime. Values keep a pointer to it, so it must outlive them.
+	template <typename UInt = uint64_t, UInt MODULUS = 0>
+	class montgomery_int
+	{
+	public:
+		using modulus_type = montgomery_modulus<UInt>;
+		static constexpr bool RUNTIME_MODULUS = (MODULUS == 0);
+	private:
+		struct static_modulus
+		{
+			static constexpr modulus_type value{ MODULUS };
+		};
+		struct no_pointer {};
+		[[no_unique_address]] std::conditional_t<RUNTIME_MODULUS, const modulus_type*, no_pointer> m_modulus;
+		UInt m_form = 0;
+
+		constexpr const modulus_type& modulus() const noexcept
+		{
+			if constexpr (RUNTIME_MODULUS)
+			{
+				return *m_modulus;
+			}
+			else
+			{
+				static_assert(MODULUS % 2 == 1 && MODULUS < (UInt{ 1 } << (std::numeric_limits<UInt>::digits - 1)), "MODULUS must be odd and below half the range of UInt.");
+				return static_modulus::value;
+			}
+		}
+
+		template <std::integral Int>
+		constexpr static UInt reduce(Int value, UInt modulus) noexcept
+		{
+			using Wide = std::make_unsigned_t<std::common_type_t<std::make_unsigned_t<Int>, UInt>>;
+			if constexpr (std::is_signed_v<Int>)
+			{
+				if (value < 0)
+				{
+					const Wide distance = static_cast<Wide>(-(value + 1));
+					return static_cast<UInt>(modulus - 1 - (distance % modulus));
+				}
+			}
+			return static_cast<UInt>(static_cast<Wide>(value) % modulus);
+		}
+
+		constexpr montgomery_int with_form(UInt form) const noexcept
+		{
+			montgomery_int result = *this;
+			result.m_form = form;
+			return result;
+		}
+
+		template <std::integral Int>
+		constexpr montgomery_int make(Int value) const noexcept
+		{
+			return with_form(modulus().to_form(reduce(value, modulus().get_modulus())));
+		}
+
+		constexpr void check_same_modulus([[maybe_unused]] const montgomery_int& other) const
+		{
+			if constexpr (RUNTIME_MODULUS)
+			{
+				AdventCheckMsg(m_modulus->get_modulus() == other.m_modulus->get_modulus(), "montgomery_int values with different moduli.");
+			}
+		}
+	public:
+		// Constructors
+		constexpr montgomery_int() noexcept requires (!RUNTIME_MODULUS) = default;
+
+		template <std::integral Int>
+		constexpr explicit montgomery_int(Int value) noexcept requires (!RUNTIME_MODULUS)
+			: m_form{ modulus().to_form(reduce(value, MODULUS)) } {}
+
+		template <std::integral Int>
+		montgomery_int(Int value, const modulus_type& mod) noexcept requires (RUNTIME_MODULUS)
+			: m_modulus{ &mod }, m_form{ mod.to_form(reduce(value, mod.get_modulus())) } {}
+
+		// Maths
+		constexpr montgomery_int& operator+=(const montgomery_int& other)
+		{
+			check_same_modulus(other);
+			m_form = modulus().add(m_form, other.m_form);
+			return *this;
+		}
+		constexpr montgomery_int& operator-=(const montgomery_int& other)
+		{
+			check_same_modulus(other);
+			m_form = modulus().subtract(m_form, other.m_form);
+			return *this;
+		}
+		constexpr montgomery_int& operator*=(const montgomery_int& other)
+		{
+			check_same_modulus(other);
+			m_form = modulus().multiply(m_form, other.m_form);
+			return *this;
+		}
+		constexpr montgomery_int& operator/=(const montgomery_int& other)
+		{
+			return (*this) *= other.inverse();
+		}
+		template <std::integral Int> constexpr montgomery_int& operator+=(Int other) { return (*this) += make(other); }
+		template <std::integral Int> constexpr montgomery_int& operator-=(Int other) { return (*this) -= make(other); }
+		template <std::integral Int> constexpr montgomery_int& operator*=(Int other) { return (*this) *= make(other); }
+		template <std::integral Int> constexpr montgomery_int& operator/=(Int other) { return (*this) /= make(other); }
+		constexpr montgomery_int& operator++() { return (*this) += 1; }
+		constexpr montgomery_int& operator--() { return (*this) -= 1; }
+		constexpr montgomery_int operator-() const { return with_form(modulus().subtract(0, m_form)); }
+
+		template <typename Other> friend constexpr montgomery_int operator+(montgomery_int left, const Other& right) { return left += right; }
+		template <typename Other> friend constexpr montgomery_int operator-(montgomery_int left, const Other& right) { return left -= right; }
+		template <typename Other> friend constexpr montgomery_int operator*(montgomery_int left, const Other& right) { return left *= right; }
+		template <typename Other> friend constexpr montgomery_int operator/(montgomery_int left, const Other& right) { return left /= right; }
+
+		constexpr montgomery_int pow(uint64_t exponent) const noexcept
+		{
+			return with_form(modulus().pow(m_form, exponent));
+		}
+
+		// The value that multiplies by this to give 1. There is only one if this and the modulus are coprime.
+		constexpr montgomery_int inverse() const
+		{
+			using Signed = std::make_signed_t<UInt>;
+			Signed old_r = static_cast<Signed>(get_value()), r = static_cast<Signed>(get_modulus());
+			Signed old_s = 1, s = 0;
+			while (r != 0)
+			{
+				const Signed quotient = old_r / r;
+				old_r = std::exchange(r, old_r - quotient * r);
+				old_s = std::exchange(s, old_s - quotient * s);
+			}
+			AdventCheckMsg(old_r == 1, "No inverse for", get_value(), "modulo", get_modulus());
+			return make(old_s);
+		}
+
+		constexpr bool operator==(const montgomery_int& other) const noexcept { return m_form == other.m_form; }
+
+		// Inspectors
+		constexpr UInt get_value() const noexcept { return modulus().from_form(m_form); }
+		constexpr UInt get_modulus() const noexcept { return modulus().get_modulus(); }
+	};
+
+	template <typename UInt, UInt MODULUS>
+	inline std::ostream& operator<<(std::ostream& os, const montgomery_int<UInt, MODULUS>& val)
+	{
+		os << val.get_value();
+		return os;
+	}
 }
 
 /*
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "../advent/advent_assert.h"
+
+namespace utils
+{
+	namespace radix_heap_internal
+	{
+		template <typename KeyType>
+		struct radix_type
+		{
+			static_assert(std::is_integral_v<KeyType>);
+			using type = std::make_unsigned_t<KeyType>;
+		};
+
+		template <>
+		struct radix_type<float> { using type = std::uint32_t; };
+
+		template <>
+		struct radix_type<double> { using type = std::uint64_t; };
+
+		// Non-negative floats keep their order when their bits are read as an unsigned integer.
+		template <typename KeyType>
+		typename radix_type<KeyType>::type to_radix(KeyType key)
+		{
+			using RadixType = typename radix_type<KeyType>::type;
+			AdventCheck(!(key < KeyType{ 0 }));
+			if constexpr (std::is_floating_point_v<KeyType>)
+			{
+				return key == KeyType{ 0 } ? RadixType{ 0 } : std::bit_cast<RadixType>(key);
+			}
+			else
+			{
+				return static_cast<RadixType>(key);
+			}
+		}
+
+		template <typename KeyType>
+		KeyType from_radix(typename radix_type<KeyType>::type radix)
+		{
+			if constexpr (std::is_floating_point_v<KeyType>)
+			{
+				return std::bit_cast<KeyType>(radix);
+			}
+			else
+			{
+				return static_cast<KeyType>(radix);
+			}
+		}
+	}
+
+	// A min-priority queue for searches where the keys popped never go down, such as
+	// Dijkstra or A* with a consistent heuristic. Keys must be non-negative integers or floats.
+	// Each entry moves between buckets at most once per bit of the key, so push is O(1) and pop is amortised O(log(max key)).
+	// Pushing a key lower than the last one popped fails an AdventCheck (in A*, that means the heuristic is not consistent).
+	template <typename KeyType, typename ValueType>
+	class radix_heap
+	{
+		using RadixType = typename radix_heap_internal::radix_type<KeyType>::type;
+		using Entry = std::pair<RadixType, ValueType>;
+		static constexpr std::size_t NUM_BUCKETS = std::numeric_limits<RadixType>::digits + 1;
+
+		std::array<std::vector<Entry>, NUM_BUCKETS> m_buckets;
+		RadixType m_last = 0;
+		std::size_t m_size = 0;
+
+		std::size_t get_bucket(RadixType radix) const noexcept
+		{
+			return static_cast<std::size_t>(std::bit_width(static_cast<RadixType>(radix ^ m_last)));
+		}
+
+		// Make sure bucket 0 holds the smallest key.
+		void refill()
+		{
+			AdventCheck(!empty());
+			if (!m_buckets[0].empty()) return;
+
+			std::size_t bucket_idx = 1;
+			while (m_buckets[bucket_idx].empty())
+			{
+				++bucket_idx;
+			}
+
+			std::vector<Entry>& bucket = m_buckets[bucket_idx];
+			RadixType new_last = std::numeric_limits<RadixType>::max();
+			for (const Entry& entry : bucket)
+			{
+				new_last = std::min(new_last, entry.first);
+			}
+			m_last = new_last;
+			for (Entry& entry : bucket)
+			{
+				m_buckets[get_bucket(entry.first)].push_back(std::move(entry));
+			}
+			bucket.clear();
+		}
+	public:
+		[[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+		[[nodiscard]] std::size_t size() const noexcept { return m_size; }
+
+		void push(KeyType key, ValueType value)
+		{
+			const RadixType radix = radix_heap_internal::to_radix(key);
+			AdventCheckMsg(radix >= m_last, "radix_heap keys must not go below the last key popped.");
+			m_buckets[get_bucket(radix)].emplace_back(radix, std::move(value));
+			++m_size;
+		}
+
+		KeyType top_key()
+		{
+			refill();
+			return radix_heap_internal::from_radix<KeyType>(m_last);
+		}
+
+		std::pair<KeyType, ValueType> pop()
+		{
+			refill();
+			Entry entry = std::move(m_buckets[0].back());
+			m_buckets[0].pop_back();
+			--m_size;
+			return std::make_pair(radix_heap_internal::from_radix<KeyType>(entry.first), std::move(entry.second));
+		}
+
+		void clear() noexcept
+		{
+			for (std::vector<Entry>& bucket : m_buckets)
+			{
+				bucket.clear();
+			}
+			m_last = 0;
+			m_size = 0;
+		}
+	};
+}
\ No newline at end of file
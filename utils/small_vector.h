@@ -55,7 +55,7 @@ namespace utils
 		constexpr void assign(std::initializer_list<T> init);
 
 		// Allocator
-		constexpr allocator_type get_allocator() const noexcept { return allocator_type(); }
+		constexpr allocator_type get_allocator() const noexcept { return m_alloc; }
 
 		// Element access
 		constexpr reference at(size_type pos);
@@ -156,6 +156,22 @@ namespace utils
 		data_access m_data;
 		std::size_t m_num_elements;
 		std::size_t m_capacity;
+		[[no_unique_address]] allocator_type m_alloc;
+
+		using alloc_traits = std::allocator_traits<allocator_type>;
+
+		// Takes other's elements, stealing its heap buffer if our allocator can free it.
+		constexpr void take_elements(small_vector& other);
+
+		// Frees the heap buffer (if any) so our allocator can be replaced by one that might not be able to free it.
+		constexpr void release_heap_before_allocator_change(const allocator_type& new_alloc)
+		{
+			if (m_alloc != new_alloc)
+			{
+				clear();
+				shrink_to_fit();
+			}
+		}
 
 		constexpr bool using_heap() const noexcept
 		{
@@ -330,7 +346,7 @@ namespace utils
 					}
 				}
 
-				AdventCheck(from.size() <= to.unitialised_memory.size());
+				AdventCheck(from.size() <= to.uninitialised_memory.size());
 				if (!to.uninitialised_memory.empty())
 				{
 					move_buffer_to_raw_memory(from, to.uninitialised_memory);
@@ -384,7 +400,6 @@ namespace utils
 
 		constexpr GapDescription make_gap_for_insert(const_iterator pos, size_type gap_size)
 		{
-			AdventCheck(size() > 0);
 			check_iterator(pos);
 			const size_type distance_from_start = std::distance(cbegin(), pos);
 			const size_type distance_from_end = std::distance(pos, cend());
@@ -406,10 +421,9 @@ namespace utils
 			}
 			else
 			{
-				for (size_type fwd_i = 0;fwd_i<gap_size;++fwd_i)
+				// Shift everything after pos along by gap_size, starting from the back.
+				for (size_type from_idx = size(); from_idx-- > distance_from_start;)
 				{
-					const size_type i = gap_size - fwd_i - 1;
-					const size_type from_idx = distance_from_start + i;
 					const size_type target_idx = from_idx + gap_size;
 					T* from_loc = data() + from_idx;
 					T* to_loc = data() + target_idx;
@@ -425,9 +439,10 @@ namespace utils
 						move_buffer_to_raw_memory(from_buf, to_buf);
 					}
 				}
+				T* const gap_start = begin() + distance_from_start;
 				return distance_from_end >= gap_size ?
-					GapDescription{ InitialisedBuffer{pos,pos + gap_size},RawMemory{} } :
-					GapDescription{ InitialisedBuffer{pos,end()},RawMemory{end(),pos + gap_size} };
+					GapDescription{ InitialisedBuffer{gap_start,gap_start + gap_size},RawMemory{} } :
+					GapDescription{ InitialisedBuffer{gap_start,end()},RawMemory{end(),gap_start + gap_size} };
 			}
 		}
 
@@ -486,7 +501,7 @@ namespace utils
 
 template <typename T, std::size_t STACK_SIZE, typename ALLOC>
 inline constexpr utils::small_vector<T, STACK_SIZE, ALLOC>::small_vector(const allocator_type& alloc) noexcept
-	: m_num_elements{ 0 }, m_capacity{ stack_buffer_size() }{}
+	: m_num_elements{ 0 }, m_capacity{ stack_buffer_size() }, m_alloc{ alloc }{}
 
 template <typename T, std::size_t STACK_SIZE, typename ALLOC>
 inline constexpr utils::small_vector<T, STACK_SIZE, ALLOC>::small_vector(size_type count, const allocator_type& alloc)
@@ -495,7 +510,7 @@ inline constexpr utils::small_vector<T, STACK_SIZE, ALLOC>::small_vector(size_ty
 template<typename T, std::size_t STACK_SIZE, typename ALLOC>
 inline constexpr typename utils::small_vector<T, STACK_SIZE, ALLOC>::size_type utils::small_vector<T, STACK_SIZE, ALLOC>::max_size() const noexcept
 {
-	return std::allocator_traits<ALLOC>::max_size(ALLOC());
+	return alloc_traits::max_size(m_alloc);
 }
 
 template<typename T, std::size_t STACK_SIZE, typename ALLOC>
@@ -515,7 +530,7 @@ inline constexpr utils::small_vector<T, STACK_SIZE, ALLOC>::small_vector(InputIt
 
 template<typename T, std::size_t STACK_SIZE, typename ALLOC>
 inline constexpr utils::small_vector<T, STACK_SIZE, ALLOC>::small_vector(const small_vector<T, STACK_SIZE, ALLOC>& other)
-	: small_vector(other,allocator_type())
+	: small_vector(other, alloc_traits::select_on_container_copy_construction(other.get_allocator()))
 {
 }
 
@@ -527,8 +542,9 @@ inline constexpr utils::small_vector<T, STACK_SIZE, ALLOC>::small_vector(const s
 
 template<typename T, std::size_t STACK_SIZE, typename ALLOC>
 inline constexpr utils::small_vector<T, STACK_SIZE, ALLOC>::small_vector(small_vector<T, STACK_SIZE, ALLOC>&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
-	: small_vector(std::forward<small_vector<T,STACK_SIZE,ALLOC>>(other),allocator_type())
+	: small_vector(other.get_allocator())
 {
+	take_elements(other);
 }
 
 template<typename T, std::size_t STACK_SIZE, typename ALLOC>
@@ -542,7 +558,7 @@ template<typename T, std::size_t STACK_SIZE, typename ALLOC>
 inline constexpr utils::small_vector<T, STACK_SIZE, ALLOC>::small_vector(small_vector<T,STACK_SIZE,ALLOC>&& other, const allocator_type& alloc)
 	: small_vector(alloc)
 {
-	*this = std::forward<small_vector<T, STACK_SIZE, ALLOC>>(other);
+	take_elements(other);
 }
 
 template<typename T, std::size_t STACK_SIZE, typename ALLOC>
@@ -550,6 +566,11 @@ inline constexpr utils::small_vector<T, STACK_SIZE, ALLOC>& utils::small_vector<
 {
 	if (&other != this)
 	{
+		if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+		{
+			release_heap_before_allocator_change(other.get_allocator());
+			m_alloc = other.get_allocator();
+		}
 		assign(other.begin(), other.end());
 	}
 	return *this;
@@ -633,7 +654,7 @@ inline constexpr void utils::small_vector<T, STACK_SIZE, ALLOC>::reserve(size_ty
 		return;
 	}
 
-	T* new_data = get_allocator().allocate(new_cap);
+	T* new_data = alloc_traits::allocate(m_alloc, new_cap);
 	const InitialisedBuffer old_buffer = get_initialised_memory();
 	const RawMemory new_buffer{ new_data,new_data + new_cap };
 	move_buffer_to_raw_memory(old_buffer,new_buffer);
@@ -641,7 +662,7 @@ inline constexpr void utils::small_vector<T, STACK_SIZE, ALLOC>::reserve(size_ty
 
 	if (using_heap())
 	{
-		get_allocator().deallocate(old_buffer.start, capacity());
+		alloc_traits::deallocate(m_alloc, old_buffer.start, capacity());
 	}
 
 	m_data.heap_data = new_data;
@@ -668,12 +689,16 @@ inline constexpr void utils::small_vector<T, STACK_SIZE, ALLOC>::shrink_to_fit()
 		{
 			return RawMemory{ get_stack_buffer(),get_stack_buffer() + size() };
 		}
-		T* new_start = get_allocator().allocate(size());
+		T* new_start = alloc_traits::allocate(m_alloc, size());
 		return RawMemory{ new_start,new_start + size() };
 	}();
 	move_buffer_to_raw_memory(old_buffer, new_buffer);
 	delete_data_in_buffer(old_buffer);
-	get_allocator().deallocate(old_buffer.start,capacity());
+	alloc_traits::deallocate(m_alloc, old_buffer.start, capacity());
+	if (size() > stack_buffer_size())
+	{
+		m_data.heap_data = new_buffer.start;
+	}
 	m_capacity = std::max(stack_buffer_size(), size());
 }
 
@@ -684,7 +709,19 @@ inline constexpr utils::small_vector<T, STACK_SIZE, ALLOC>& utils::small_vector<
 	{
 		return *this;
 	}
-	if (other.using_heap())
+	if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+	{
+		release_heap_before_allocator_change(other.get_allocator());
+		m_alloc = std::move(other.m_alloc);
+	}
+	take_elements(other);
+	return *this;
+}
+
+template<typename T, std::size_t STACK_SIZE, typename ALLOC>
+inline constexpr void utils::small_vector<T, STACK_SIZE, ALLOC>::take_elements(small_vector& other)
+{
+	if (other.using_heap() && m_alloc == other.m_alloc)
 	{
 		clear();
 		shrink_to_fit();
@@ -693,15 +730,19 @@ inline constexpr utils::small_vector<T, STACK_SIZE, ALLOC>& utils::small_vector<
 		m_num_elements = other.size();
 		other.m_capacity = other.stack_buffer_size();
 		other.m_num_elements = 0;
-		return *this;
+		return;
+	}
+
+	if (capacity() < other.size())
+	{
+		clear();
+		reserve(other.size());
 	}
-	
-	AdventCheck(capacity() >= other.size());
 	if constexpr (std::is_trivially_copy_assignable_v<T>)
 	{
 		std::memcpy(begin(), other.begin(), sizeof(T) * other.size());
 		m_num_elements = other.size();
-		return *this;
+		return;
 	}
 
 	if (size() == other.size())
@@ -719,7 +760,7 @@ inline constexpr utils::small_vector<T, STACK_SIZE, ALLOC>& utils::small_vector<
 		delete_data_in_buffer(InitialisedBuffer{ begin() + other.size(),end() });
 	}
 	m_num_elements = other.size();
-	return *this;
+	return;
 }
 
 template<typename T, std::size_t STACK_SIZE, typename ALLOC>
@@ -736,7 +777,7 @@ inline constexpr typename utils::small_vector<T, STACK_SIZE, ALLOC>::iterator ut
 	//AdventCheck(gap.initialized_memory.size() != gap.uninitialised_memory.size());
 	move_buffer_to_memory(Buffer{ &value,(&value) + 1 }, gap);
 	++m_num_elements;
-	return gap.initialised_memory.empty() ? gap.uninitialised_memory.finish : gap.initialised_memory.finish;
+	return gap.initialised_memory.empty() ? gap.uninitialised_memory.start : gap.initialised_memory.start;
 }
 
 template<typename T, std::size_t STACK_SIZE, typename ALLOC>
@@ -745,7 +786,7 @@ inline constexpr typename utils::small_vector<T, STACK_SIZE, ALLOC>::iterator ut
 	const GapDescription gap = make_gap_for_insert(pos, count);
 	fill_memory(gap, value);
 	m_num_elements += count;
-	return gap.initialised_memory.empty() ? gap.uninitialised_memory.finish : gap.initialised_memory.finish;
+	return gap.initialised_memory.empty() ? gap.uninitialised_memory.start : gap.initialised_memory.start;
 }
 
 template<typename T, std::size_t STACK_SIZE, typename ALLOC>
@@ -765,14 +806,9 @@ inline constexpr typename utils::small_vector<T, STACK_SIZE, ALLOC>::iterator ut
 	if (pos == cend())
 	{
 		emplace_back(std::forward<Args>(args)...);
-		return end();
+		return end() - 1;
 	}
-	GapDescription gap = make_gap_for_insert(pos, 1);
-	AdventCheck(gap.initialised_memory.size() == 1);
-	AdventCheck(gap.uninitualised_memory.empty());
-	*gap.initialised_memory.first = T(std::forward<Args>(args)...);
-	++m_num_elements;
-	return gap.initialised_memory.last;
+	return insert(pos, T(std::forward<Args>(args)...));
 }
 
 template<typename T, std::size_t STACK_SIZE, typename ALLOC>
@@ -795,7 +831,7 @@ inline constexpr typename utils::small_vector<T, STACK_SIZE, ALLOC>::iterator ut
 			uninit = new(uninit) T(*(it++));
 		}
 		m_num_elements += size_increase;
-		return gap.get_unified_buffer().finish;
+		return gap.get_unified_buffer().start;
 	}
 	// Can't use std::difference
 	for (auto it = first; it != last; ++it)
@@ -896,14 +932,21 @@ inline constexpr void utils::small_vector<T, STACK_SIZE, ALLOC>::resize(size_typ
 template<typename T, std::size_t STACK_SIZE, typename ALLOC>
 inline constexpr void utils::small_vector<T, STACK_SIZE, ALLOC>::swap(small_vector& other) noexcept
 {
-	if (using_heap() && other.using_heap())
+	constexpr bool swap_allocators = alloc_traits::propagate_on_container_swap::value;
+	if (using_heap() && other.using_heap() && (swap_allocators || m_alloc == other.m_alloc))
 	{
 		std::swap(m_data.heap_data, other.m_data.heap_data);
+		std::swap(m_num_elements, other.m_num_elements);
+		std::swap(m_capacity, other.m_capacity);
+		if constexpr (swap_allocators)
+		{
+			std::swap(m_alloc, other.m_alloc);
+		}
 	}
 	else
 	{
 		small_vector<T, STACK_SIZE, ALLOC> temp = std::move(other);
-		other = std::move(this);
+		other = std::move(*this);
 		*this = std::move(temp);
 	}
 }
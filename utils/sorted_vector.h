@@ -9,13 +9,15 @@
 
 namespace utils
 {
-	template <typename T, typename BinaryPred = std::less<T>, std::size_t BufferSize = 1>
+	template <typename T, typename BinaryPred = std::less<T>, std::size_t BufferSize = 1, typename Alloc = std::allocator<T>>
 	class sorted_vector
 	{
 	public:
-		using iterator = typename utils::small_vector<T,BufferSize>::iterator;
-		using const_iterator = typename utils::small_vector<T,BufferSize>::const_iterator;
+		using storage_type = utils::small_vector<T, BufferSize, Alloc>;
+		using iterator = typename storage_type::iterator;
+		using const_iterator = typename storage_type::const_iterator;
 		using value_type = T;
+		using allocator_type = Alloc;
 		bool can_insert_at_pos(const_iterator pos, const T& value) const noexcept
 		{
 			const bool check_after = (pos == m_data.cend() || !m_compare(*pos, value));
@@ -30,28 +32,85 @@ namespace utils
 			return false;
 		}
 	protected:
-		mutable utils::small_vector<T,BufferSize> m_data;
+		mutable storage_type m_data;
 		BinaryPred m_compare;
 		mutable bool m_sorted;
+
+		// When not sorted, this many elements at the front are still in order (they were there before the
+		// out-of-order appends), so sort() only has to sort the rest and merge the two.
+		mutable std::size_t m_num_sorted = 0;
+
+		// Call before appending anything, so the elements already there are remembered as sorted.
+		void mark_unsorted_after_append() const noexcept
+		{
+			if (m_sorted)
+			{
+				m_num_sorted = m_data.size();
+				m_sorted = false;
+			}
+		}
+
+		// Removes all but the first of each run of equivalent elements. Must be sorted.
+		void erase_equivalent_neighbours()
+		{
+			AdventCheck(m_sorted);
+			const auto is_equivalent = [this](const T& earlier, const T& later) { return !m_compare(earlier, later); };
+			const auto new_end = std::unique(m_data.begin(), m_data.end(), is_equivalent);
+			m_data.erase(new_end, m_data.end());
+		}
+
+		template <typename Range>
+		void append_range(Range&& range)
+		{
+			if constexpr (stdr::sized_range<Range>)
+			{
+				m_data.reserve(m_data.size() + stdr::size(range));
+			}
+			if constexpr (std::is_rvalue_reference_v<Range&&>)
+			{
+				stdr::move(range, std::back_inserter(m_data));
+			}
+			else
+			{
+				stdr::copy(range, std::back_inserter(m_data));
+			}
+		}
+
+		// Merges everything after the first num_sorted elements, which must already be in order, into them.
+		void merge_tail(std::size_t num_sorted) const
+		{
+			const auto middle = m_data.begin() + num_sorted;
+			std::inplace_merge(m_data.begin(), middle, m_data.end(), m_compare);
+			m_sorted = true;
+		}
 	public:
 		sorted_vector() : sorted_vector(BinaryPred{}) {}
-		explicit sorted_vector(const BinaryPred& compare)
-			: m_data()
+		explicit sorted_vector(const BinaryPred& compare, const Alloc& alloc = Alloc{})
+			: m_data(alloc)
 			, m_compare(compare)
 			, m_sorted(true)
 		{
 			assert(m_data.empty());
 		}
+		explicit sorted_vector(const Alloc& alloc) : sorted_vector(BinaryPred{}, alloc) {}
 		template <typename InputIt>
 		sorted_vector(InputIt start, InputIt finish) : sorted_vector(start, finish, BinaryPred{}) {}
 
 		template <typename InputIt>
-		sorted_vector(InputIt start, InputIt finish, BinaryPred compare)
-			: m_data(start, finish)
+		sorted_vector(InputIt start, InputIt finish, BinaryPred compare, const Alloc& alloc = Alloc{})
+			: m_data(start, finish, alloc)
 			, m_compare(compare)
 			, m_sorted(false)
 		{}
 
+		// Copies other's elements into memory from alloc.
+		sorted_vector(const sorted_vector& other, const Alloc& alloc)
+			: m_data(other.m_data, alloc)
+			, m_compare(other.m_compare)
+			, m_sorted(other.m_sorted)
+			, m_num_sorted(other.m_num_sorted)
+		{}
+
 		sorted_vector(std::initializer_list<T> ilist) : sorted_vector(ilist.begin(), ilist.end())
 		{
 			AdventCheck(m_data.size() == ilist.size());
@@ -62,6 +121,11 @@ namespace utils
 		sorted_vector& operator=(const sorted_vector&) = default;
 		sorted_vector& operator=(sorted_vector&&) = default;
 
+		allocator_type get_allocator() const noexcept
+		{
+			return m_data.get_allocator();
+		}
+
 		void reserve(std::size_t new_capacity)
 		{
 			m_data.reserve(new_capacity);
@@ -71,8 +135,9 @@ namespace utils
 		{
 			if (!m_sorted)
 			{
-				stdr::sort(m_data, m_compare);
-				m_sorted = true;
+				AdventCheck(m_num_sorted <= m_data.size());
+				std::sort(m_data.begin() + m_num_sorted, m_data.end(), m_compare);
+				merge_tail(m_num_sorted);
 			}
 		}
 
@@ -249,6 +314,7 @@ namespace utils
 				const auto idx = std::distance(cbegin(), pos);
 				m_data[idx] = m_data.back();
 				m_sorted = false;
+				m_num_sorted = static_cast<std::size_t>(idx);
 			}
 			m_data.pop_back();
 		}
@@ -282,6 +348,7 @@ namespace utils
 				{
 					*search_pos = std::move(m_data.back());
 					m_sorted = false;
+					m_num_sorted = 0;
 					--new_end;
 				}
 				else
@@ -294,8 +361,49 @@ namespace utils
 		template <typename InputIterator>
 		void insert(InputIterator first, InputIterator last)
 		{
+			mark_unsorted_after_append();
 			m_data.insert(end(m_data), first, last);
-			m_sorted = false;
+		}
+
+		// Adds every element of range, keeping duplicates. The new elements are only appended: the next lookup
+		// sorts just them and merges them in, so this is O(n + k log k) rather than shifting the tail for each one.
+		template <stdr::input_range Range>
+		void insert_range(Range&& range)
+		{
+			mark_unsorted_after_append();
+			append_range(std::forward<Range>(range));
+		}
+
+		// Adds the elements of range that are not equivalent to one already here (or earlier in range).
+		// Any duplicates that were already here are removed too.
+		template <stdr::input_range Range>
+		void insert_range_unique(Range&& range)
+		{
+			sort();
+			const std::size_t num_sorted = m_data.size();
+			append_range(std::forward<Range>(range));
+			std::stable_sort(m_data.begin() + num_sorted, m_data.end(), m_compare);
+			merge_tail(num_sorted);
+			erase_equivalent_neighbours();
+		}
+
+		// As insert_range, for a range that is already sorted, which is merged in straight away in O(n + k).
+		template <stdr::input_range Range>
+		void merge_sorted(Range&& range)
+		{
+			sort();
+			const std::size_t num_sorted = m_data.size();
+			append_range(std::forward<Range>(range));
+			AdventCheck(std::is_sorted(m_data.begin() + num_sorted, m_data.end(), m_compare));
+			merge_tail(num_sorted);
+		}
+
+		// As insert_range_unique, for a range that is already sorted.
+		template <stdr::input_range Range>
+		void merge_sorted_unique(Range&& range)
+		{
+			merge_sorted(std::forward<Range>(range));
+			erase_equivalent_neighbours();
 		}
 
 		// Implies keep_sorted = true. Tries to insert just before hint.
@@ -346,14 +454,16 @@ namespace utils
 
 		iterator insert(T&& value)
 		{
-			m_sorted = m_data.empty() || (m_sorted && !m_compare(value, m_data.back()));
+			if (m_data.empty()) m_sorted = true;
+			else if (m_compare(value, m_data.back())) mark_unsorted_after_append();
 			m_data.push_back(std::forward<T>(value));
 			return m_data.end() - 1;
 		}
 
 		iterator insert(const T& value)
 		{
-			m_sorted = m_data.empty() || (m_sorted && !m_compare(value, m_data.back()));
+			if (m_data.empty()) m_sorted = true;
+			else if (m_compare(value, m_data.back())) mark_unsorted_after_append();
 			m_data.push_back(value);
 			return m_data.end() - 1;
 		}
@@ -418,6 +528,7 @@ namespace utils
 		void pop_back()
 		{
 			m_data.pop_back();
+			m_num_sorted = std::min(m_num_sorted, m_data.size());
 		}
 
 		// Erase all non-unique elements. Turns a multiset into a set, effectively.
@@ -428,9 +539,12 @@ namespace utils
 			m_data.erase(eraseable_range.begin(), eraseable_range.end());
 		}
 
-		void swap(sorted_vector<T>& other)
+		void swap(sorted_vector& other)
 		{
 			m_data.swap(other.m_data);
+			std::swap(m_compare, other.m_compare);
+			std::swap(m_sorted, other.m_sorted);
+			std::swap(m_num_sorted, other.m_num_sorted);
 		}
 
 		T& operator[](std::size_t index)
@@ -494,11 +608,12 @@ namespace utils
 		}
 	};
 
-	template<typename KeyType, typename MappedType, typename KeyCompare = std::less<KeyType>, std::size_t BufferSize = 1>
-	class flat_map : public sorted_vector<std::pair<KeyType, MappedType>, MapComparator<KeyType, MappedType, KeyCompare>, BufferSize>
+	template<typename KeyType, typename MappedType, typename KeyCompare = std::less<KeyType>, std::size_t BufferSize = 1, typename Alloc = std::allocator<std::pair<KeyType, MappedType>>>
+	class flat_map : public sorted_vector<std::pair<KeyType, MappedType>, MapComparator<KeyType, MappedType, KeyCompare>, BufferSize, Alloc>
 	{
 	public:
- 		using underlying_type = sorted_vector<std::pair<KeyType, MappedType>, MapComparator<KeyType, MappedType, KeyCompare>, BufferSize>;
+ 		using underlying_type = sorted_vector<std::pair<KeyType, MappedType>, MapComparator<KeyType, MappedType, KeyCompare>, BufferSize, Alloc>;
+ 		using underlying_type::underlying_type;
  		using underlying_type::operator[];
  		using underlying_type::insert;
  		using iterator = underlying_type::iterator;
@@ -566,7 +681,7 @@ namespace utils
 			{
 				if (insert_pos == underlying_type::end()) return true;
 				KeyCompare comp{};
-				return !comp(key, insert_pos->first);
+				return comp(key, insert_pos->first);
 			}();
 			if (can_insert_at_pos)
 			{
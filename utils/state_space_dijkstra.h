@@ -0,0 +1,116 @@
+#pragma once
+
+#include <vector>
+#include <limits>
+#include <optional>
+#include <algorithm>
+
+#include "../advent/advent_assert.h"
+#include "bucket_queue.h"
+
+namespace utils
+{
+	// Dijkstra's algorithm over states that the caller has numbered 0..num_states-1,
+	// with non-negative integer step costs. Costs and visited flags are flat arrays indexed by state,
+	// and the open set is a bucket_queue, so a search is roughly linear in the number of states explored.
+	// Encode whatever makes up a state (e.g. location, direction and run length) into the state number.
+	class state_space_dijkstra
+	{
+	public:
+		static constexpr std::size_t NO_STATE = std::numeric_limits<std::size_t>::max();
+		static constexpr std::size_t UNREACHED = std::numeric_limits<std::size_t>::max();
+	private:
+		std::vector<std::size_t> m_costs;
+		std::vector<std::size_t> m_previous;
+		std::vector<bool> m_settled;
+		utils::bucket_queue<std::size_t> m_queue;
+	public:
+		explicit state_space_dijkstra(std::size_t num_states)
+			: m_costs(num_states, UNREACHED)
+			, m_previous(num_states, NO_STATE)
+			, m_settled(num_states, false)
+		{}
+
+		std::size_t num_states() const noexcept { return m_costs.size(); }
+
+		void add_start(std::size_t state, std::size_t cost = 0)
+		{
+			AdventCheck(state < num_states());
+			if (cost < m_costs[state])
+			{
+				m_costs[state] = cost;
+				m_previous[state] = NO_STATE;
+				m_queue.push(cost, state);
+			}
+		}
+
+		// IsEndState: bool f(std::size_t state)
+		// GetNextStates: void f(std::size_t state, auto& add_next), where add_next(std::size_t next_state, std::size_t step_cost) is called for each next state.
+		// Returns the first end state reached, which is one of the cheapest. Can be called again to carry on to the next one.
+		template <typename IsEndState, typename GetNextStates>
+		std::optional<std::size_t> run(const IsEndState& is_end_state, const GetNextStates& get_next_states)
+		{
+			std::size_t current_state = NO_STATE;
+			auto add_next = [this, &current_state](std::size_t next_state, std::size_t step_cost)
+			{
+				AdventCheck(next_state < num_states());
+				if (m_settled[next_state]) return;
+				const std::size_t next_cost = m_costs[current_state] + step_cost;
+				if (next_cost >= m_costs[next_state]) return;
+				m_costs[next_state] = next_cost;
+				m_previous[next_state] = current_state;
+				m_queue.push(next_cost, next_state);
+			};
+
+			while (!m_queue.empty())
+			{
+				current_state = m_queue.pop().second;
+				if (m_settled[current_state])
+				{
+					continue;
+				}
+				m_settled[current_state] = true;
+				// Expanded even if it is an end state, so a later call carries on from here.
+				get_next_states(current_state, add_next);
+				if (is_end_state(current_state))
+				{
+					return current_state;
+				}
+			}
+			return std::nullopt;
+		}
+
+		// Runs until every reachable state is settled.
+		template <typename GetNextStates>
+		void run_all(const GetNextStates& get_next_states)
+		{
+			run([](std::size_t) { return false; }, get_next_states);
+		}
+
+		std::size_t get_cost(std::size_t state) const
+		{
+			AdventCheck(state < num_states());
+			return m_costs[state];
+		}
+
+		bool is_settled(std::size_t state) const
+		{
+			AdventCheck(state < num_states());
+			return m_settled[state];
+		}
+
+		// From a start state to end_state inclusive.
+		std::vector<std::size_t> get_path(std::size_t end_state) const
+		{
+			AdventCheck(end_state < num_states());
+			std::vector<std::size_t> result;
+			if (m_costs[end_state] == UNREACHED) return result;
+			for (std::size_t state = end_state; state != NO_STATE; state = m_previous[state])
+			{
+				result.push_back(state);
+			}
+			std::reverse(begin(result), end(result));
+			return result;
+		}
+	};
+}
\ No newline at end of file
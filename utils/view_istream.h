@@ -0,0 +1,82 @@
+#pragma once
+
+#include <string_view>
+#include <istream>
+#include <streambuf>
+#include <algorithm>
+
+namespace utils
+{
+	// A read-only stream buffer over characters owned by someone else. Nothing is copied.
+	class view_streambuf : public std::streambuf
+	{
+	public:
+		explicit view_streambuf(std::string_view view) noexcept
+		{
+			// The get area is never written to, so dropping const is safe.
+			char* first = const_cast<char*>(view.data());
+			setg(first, first, first + view.size());
+		}
+		view_streambuf(const view_streambuf&) = default;
+		view_streambuf& operator=(const view_streambuf&) = default;
+
+		std::string_view view() const noexcept
+		{
+			return std::string_view{ eback(), static_cast<std::size_t>(egptr() - eback()) };
+		}
+
+		// The part that has not been read yet.
+		std::string_view remaining() const noexcept
+		{
+			return std::string_view{ gptr(), static_cast<std::size_t>(egptr() - gptr()) };
+		}
+
+		// Marks the next num_chars as read, for code that parses remaining() directly.
+		void consume(std::size_t num_chars) noexcept
+		{
+			setg(eback(), gptr() + std::min(num_chars, remaining().size()), egptr());
+		}
+	protected:
+		pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+		{
+			if ((which & std::ios_base::in) == 0) return pos_type(off_type(-1));
+			off_type base = 0;
+			switch (dir)
+			{
+			case std::ios_base::beg: base = 0; break;
+			case std::ios_base::cur: base = gptr() - eback(); break;
+			case std::ios_base::end: base = egptr() - eback(); break;
+			default: return pos_type(off_type(-1));
+			}
+			const off_type target = base + off;
+			if (target < 0 || target > egptr() - eback()) return pos_type(off_type(-1));
+			setg(eback(), eback() + target, egptr());
+			return pos_type(target);
+		}
+
+		pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+		{
+			return seekoff(off_type(pos), std::ios_base::beg, which);
+		}
+	};
+
+	// An istream reading straight out of a string_view, for code written against std::istream.
+	class view_istream : public std::istream
+	{
+		view_streambuf m_buf;
+	public:
+		explicit view_istream(std::string_view view) : std::istream{ nullptr }, m_buf{ view }
+		{
+			rdbuf(&m_buf);
+		}
+		view_istream(view_istream&& other) : std::istream{ std::move(other) }, m_buf{ other.m_buf }
+		{
+			set_rdbuf(&m_buf);
+		}
+		view_istream(const view_istream&) = delete;
+		view_istream& operator=(const view_istream&) = delete;
+
+		// Everything in the underlying buffer, including anything already read.
+		std::string_view view() const noexcept { return m_buf.view(); }
+	};
+}
\ No newline at end of file
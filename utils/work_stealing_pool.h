@@ -0,0 +1,184 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <algorithm>
+
+namespace utils
+{
+	// A fixed set of worker threads for running independent tasks.
+	// Every worker owns a queue. Workers take new work from the back of their own queue
+	// and, when that runs dry, steal from the front of the other workers' queues.
+	// Tasks must not throw: an escaping exception will terminate the program.
+	class work_stealing_pool
+	{
+	public:
+		using task = std::function<void()>;
+	private:
+		struct worker_queue
+		{
+			std::mutex lock;
+			std::deque<task> tasks;
+		};
+
+		std::vector<std::unique_ptr<worker_queue>> m_queues;
+		std::vector<std::thread> m_threads;
+
+		// Everything below is guarded by m_state_lock.
+		std::mutex m_state_lock;
+		std::condition_variable m_work_available;
+		std::condition_variable m_all_done;
+		std::size_t m_num_queued = 0;
+		std::size_t m_num_unfinished = 0;
+		std::size_t m_next_queue = 0;
+		bool m_stopping = false;
+
+		// Which pool (if any) the current thread works for, and its queue in that pool.
+		static inline thread_local const work_stealing_pool* t_current_pool = nullptr;
+		static inline thread_local std::size_t t_current_idx = 0;
+
+		std::optional<task> try_pop_from(std::size_t queue_idx, bool steal)
+		{
+			worker_queue& queue = *m_queues[queue_idx];
+			std::scoped_lock lock{ queue.lock };
+			if (queue.tasks.empty())
+			{
+				return std::nullopt;
+			}
+			task result = steal ? std::move(queue.tasks.front()) : std::move(queue.tasks.back());
+			if (steal)
+			{
+				queue.tasks.pop_front();
+			}
+			else
+			{
+				queue.tasks.pop_back();
+			}
+			return result;
+		}
+
+		std::optional<task> try_get_task(std::size_t worker_idx)
+		{
+			if (auto own = try_pop_from(worker_idx, false))
+			{
+				return own;
+			}
+			for (std::size_t offset = 1; offset < m_queues.size(); ++offset)
+			{
+				const std::size_t victim = (worker_idx + offset) % m_queues.size();
+				if (auto stolen = try_pop_from(victim, true))
+				{
+					return stolen;
+				}
+			}
+			return std::nullopt;
+		}
+
+		void worker_loop(std::size_t worker_idx)
+		{
+			t_current_pool = this;
+			t_current_idx = worker_idx;
+			while (true)
+			{
+				std::optional<task> next = try_get_task(worker_idx);
+				if (!next.has_value())
+				{
+					std::unique_lock lock{ m_state_lock };
+					if (m_stopping && m_num_queued == 0)
+					{
+						return;
+					}
+					m_work_available.wait(lock, [this]() { return m_stopping || m_num_queued > 0; });
+					continue;
+				}
+
+				{
+					std::scoped_lock lock{ m_state_lock };
+					--m_num_queued;
+				}
+
+				(*next)();
+
+				std::scoped_lock lock{ m_state_lock };
+				--m_num_unfinished;
+				if (m_num_unfinished == 0)
+				{
+					m_all_done.notify_all();
+				}
+			}
+		}
+	public:
+		// num_threads == 0 uses one thread per hardware thread.
+		explicit work_stealing_pool(std::size_t num_threads)
+		{
+			if (num_threads == 0)
+			{
+				num_threads = std::max(std::size_t{ 1 }, static_cast<std::size_t>(std::thread::hardware_concurrency()));
+			}
+			m_queues.reserve(num_threads);
+			for (std::size_t i = 0; i < num_threads; ++i)
+			{
+				m_queues.push_back(std::make_unique<worker_queue>());
+			}
+			m_threads.reserve(num_threads);
+			for (std::size_t i = 0; i < num_threads; ++i)
+			{
+				m_threads.emplace_back([this, i]() { worker_loop(i); });
+			}
+		}
+
+		work_stealing_pool(const work_stealing_pool&) = delete;
+		work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+
+		// Finishes all submitted work before returning.
+		~work_stealing_pool()
+		{
+			{
+				std::scoped_lock lock{ m_state_lock };
+				m_stopping = true;
+			}
+			m_work_available.notify_all();
+			for (std::thread& t : m_threads)
+			{
+				t.join();
+			}
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return m_threads.size();
+		}
+
+		// Tasks submitted from a worker go onto that worker's own queue.
+		// Tasks submitted from anywhere else are dealt out to the queues in turn.
+		void submit(task new_task)
+		{
+			{
+				// The task is counted as queued only once it is in a queue, so a woken worker always finds it.
+				std::scoped_lock lock{ m_state_lock };
+				const std::size_t queue_idx = (t_current_pool == this) ? t_current_idx : (m_next_queue++ % m_queues.size());
+				{
+					worker_queue& queue = *m_queues[queue_idx];
+					std::scoped_lock queue_lock{ queue.lock };
+					queue.tasks.push_back(std::move(new_task));
+				}
+				++m_num_queued;
+				++m_num_unfinished;
+			}
+			m_work_available.notify_one();
+		}
+
+		// Blocks until every submitted task has finished. Must not be called from a worker.
+		void wait_idle()
+		{
+			std::unique_lock lock{ m_state_lock };
+			m_all_done.wait(lock, [this]() { return m_num_unfinished == 0; });
+		}
+	};
+}
\ No newline at end of file